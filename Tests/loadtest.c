@@ -0,0 +1,800 @@
+/*
+Copyright (C) 2025 Tripp Robins
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this
+software and associated documentation files (the "Software"), to deal in the Software
+without restriction, including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "../c_polygon.h"
+
+#include "test_common.h"
+
+#include <stdio.h>
+#include <crtdbg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/*
+* Checks the results of loading the files in res/ against known values.
+* Run it with /Tests as the working directory, it prints every failed check and exits with EXIT_FAILURE if there were any.
+*/
+
+static int failedCheckCount = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("Check failed (line %d): %s\n", __LINE__, #cond); ++failedCheckCount; } } while (0)
+
+static void checkObjectInfo(const struct PlyScene* scene, const char* name, const double value)
+{
+    U32 i = 0;
+    for (; i < scene->objectInfoCount; ++i) {
+        if (strcmp(scene->objectInfos[i].name, name) == 0) {
+            if (scene->objectInfos[i].value != value) {
+                printf("Check failed: obj_info %s is %f, expected %f\n", name, scene->objectInfos[i].value, value);
+                ++failedCheckCount;
+            }
+            return;
+        }
+    }
+    printf("Check failed: obj_info %s is missing\n", name);
+    ++failedCheckCount;
+}
+
+static void testObjectInfos(void)
+{
+    struct PlyScene scene = { 0 };
+    struct PlyLoadInfo loadInfo = { 0 };
+    CHECK(PlyLoadFromDisk("res/bun000.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    CHECK(scene.objectInfoCount == 15);
+    checkObjectInfo(&scene, "is_cyberware_data", 1);
+    checkObjectInfo(&scene, "is_mesh", 0);
+    checkObjectInfo(&scene, "num_cols", 512);
+    checkObjectInfo(&scene, "num_rows", 400);
+    checkObjectInfo(&scene, "echo_rgb_offset_x", 0.013);
+    checkObjectInfo(&scene, "echo_rgb_offset_y", 0.1536);
+    checkObjectInfo(&scene, "echo_rgb_pixelsize", 0.00001);
+    checkObjectInfo(&scene, "echo_rgb_centerpixel", 232);
+    checkObjectInfo(&scene, "echo_frames", 512);
+    checkObjectInfo(&scene, "echo_lgincr", 0.0005);
+    PlyDestroyScene(&scene);
+
+    /* values longer than any fixed buffer, and values followed by more text */
+    const char header[] =
+        "ply\n"
+        "format ascii 1.0\n"
+        "obj_info long 1.2500000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000\n"
+        "obj_info trailing 7 ignored\n"
+        "obj_info last 3\n"
+        "element vertex 0\n"
+        "property float x\n"
+        "end_header\n";
+    CHECK(PlyLoadFromMemory((const U8*)header, sizeof(header) - 1, &scene, &loadInfo) == PLY_SUCCESS);
+    CHECK(scene.objectInfoCount == 3);
+    checkObjectInfo(&scene, "long", 1.25);
+    checkObjectInfo(&scene, "trailing", 7);
+    checkObjectInfo(&scene, "last", 3);
+    PlyDestroyScene(&scene);
+}
+
+/* a scene loaded into an arena can be read and destroyed, but nothing can be added to it */
+static void testArenaSceneIsReadOnly(void)
+{
+    struct PlyScene scene = { 0 };
+    struct PlyLoadInfo loadInfo = { .sceneArena = true };
+    CHECK(PlyLoadFromDisk("res/cube.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    CHECK(scene.arena != NULL);
+    CHECK(scene.elementCount == 2);
+    if (scene.elementCount != 2) {
+        PlyDestroyScene(&scene);
+        return;
+    }
+
+    struct PlyElement* vertex = scene.elements;
+    CHECK(vertex->inArena);
+    struct PlyProperty w = { .name = "w", .dataType = PLY_DATA_TYPE_SCALAR, .scalarType = PLY_SCALAR_TYPE_FLOAT };
+    CHECK(PlyWriteProperty(vertex, &w) == PLY_GENERIC_ERROR);
+    CHECK(PlyCreateDataLines(vertex, 10) == PLY_GENERIC_ERROR);
+    CHECK(PlyWriteData(vertex, 0, 0, (union PlyScalarUnion) { .f32 = 1.0f }) == PLY_GENERIC_ERROR);
+    CHECK(PlyWriteComment(&scene, "comment") == PLY_GENERIC_ERROR);
+    CHECK(PlyWriteObjectInfo(&scene, "info", 1.0) == PLY_GENERIC_ERROR);
+    struct PlyElement extra = { .name = "extra" };
+    CHECK(PlyWriteElement(&scene, &extra) == PLY_GENERIC_ERROR);
+
+    struct PlyScene other = { 0 };
+    CHECK(PlyWriteElement(&other, vertex) == PLY_GENERIC_ERROR);
+    CHECK(other.elementCount == 0);
+    PlyDestroyScene(&other);
+
+    CHECK(vertex->propertyCount == 3);
+    CHECK(vertex->dataLineCount == 8);
+    CHECK(PlyGetPropertyIndexByName(vertex, "z") == 2);
+    PlyDestroyScene(&scene);
+}
+
+static void testRenamedElementLookup(void)
+{
+    struct PlyScene scene = { 0 };
+    struct PlyLoadInfo loadInfo = { 0 };
+    CHECK(PlyLoadFromDisk("res/cube.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    CHECK(scene.elementCount == 2);
+    if (scene.elementCount != 2) {
+        PlyDestroyScene(&scene);
+        return;
+    }
+
+    CHECK(PlyElementSetName(&scene.elements[0], "point") == PLY_SUCCESS);
+    struct PlyNameHandle point = PlyInternName("point");
+    CHECK(PlyGetElementIndexByName(&scene, "point") == 0);
+    CHECK(PlyGetElementIndexByHandle(&scene, &point) == 0);
+    CHECK(PlyGetElementIndexByName(&scene, "vertex") == -1);
+    CHECK(PlyGetElementIndexByName(&scene, "face") == 1);
+
+    /* adding an element refills the table with the new name */
+    struct PlyElement extra = { .name = "extra" };
+    CHECK(PlyWriteElement(&scene, &extra) == PLY_SUCCESS);
+    CHECK(PlyWriteElement(&scene, &extra) == PLY_GENERIC_ERROR);
+    CHECK(PlyGetElementIndexByName(&scene, "point") == 0);
+    CHECK(PlyGetElementIndexByName(&scene, "vertex") == -1);
+    CHECK(PlyGetElementIndexByName(&scene, "face") == 1);
+    CHECK(PlyGetElementIndexByName(&scene, "extra") == 2);
+    PlyDestroyScene(&scene);
+}
+
+/* the files in res/ that every load mode is compared on */
+static const char* const testFiles[] = { "res/cube.ply", "res/cube_bin.ply", "res/cube_blndr.ply", "res/bun_zipper.ply", "res/bun000.ply" };
+
+/* every mode must load the same values as the default PlyLoadInfo */
+static const struct PlyLoadInfo loadModes[] = {
+    { .compactDataLines = true },
+    { .threadCount = 4u },
+    { .compactDataLines = true, .threadCount = 4u },
+    { .denseLists = true },
+    { .compactDataLines = true, .denseLists = true, .threadCount = 4u },
+    { .columnarData = true },
+    { .columnarData = true, .threadCount = 4u },
+    { .sceneArena = true },
+    { .sceneArena = true, .compactDataLines = true, .denseLists = true, .threadCount = 4u },
+    { .sceneArena = true, .columnarData = true },
+};
+
+static double readScalar(const U8* data, const enum PlyScalarType type)
+{
+    I8 i8; U8 u8; I16 i16; U16 u16; I32 i32; U32 u32; float f32; double d64;
+    switch (type) {
+    case PLY_SCALAR_TYPE_CHAR: memcpy(&i8, data, sizeof(i8)); return i8;
+    case PLY_SCALAR_TYPE_UCHAR: memcpy(&u8, data, sizeof(u8)); return u8;
+    case PLY_SCALAR_TYPE_SHORT: memcpy(&i16, data, sizeof(i16)); return i16;
+    case PLY_SCALAR_TYPE_USHORT: memcpy(&u16, data, sizeof(u16)); return u16;
+    case PLY_SCALAR_TYPE_INT: memcpy(&i32, data, sizeof(i32)); return i32;
+    case PLY_SCALAR_TYPE_UINT: memcpy(&u32, data, sizeof(u32)); return u32;
+    case PLY_SCALAR_TYPE_FLOAT: memcpy(&f32, data, sizeof(f32)); return f32;
+    case PLY_SCALAR_TYPE_DOUBLE: memcpy(&d64, data, sizeof(d64)); return d64;
+    default: return 0.0;
+    }
+}
+
+/* the value of a property of an element loaded with the default PlyLoadInfo, which has data line tables */
+static const U8* getReferenceValue(const struct PlyElement* element, const U32 propertyIdx, const U32 dataLineIdx)
+{
+    return (const U8*)element->data + element->dataLineBegins[dataLineIdx] + element->properties[propertyIdx].dataLineOffsets[dataLineIdx];
+}
+
+/* compares a scalar property of element, read with PlyExtractColumn, to the same property of reference */
+static void compareScalarProperty(const struct PlyElement* reference, const U32 referenceIdx, const struct PlyElement* element, const U32 propertyIdx)
+{
+    const U32 count = element->dataLineCount;
+    double* values = (double*)malloc(sizeof(double) * (count + 1u));
+    CHECK(PlyExtractColumn(element, propertyIdx, PLY_SCALAR_TYPE_DOUBLE, values, 0u, count, false) == PLY_SUCCESS);
+    const enum PlyScalarType type = reference->properties[referenceIdx].scalarType;
+    U32 mismatchCount = 0u;
+    U32 dli = 0u;
+    for (; dli < count; ++dli) {
+        if (values[dli] != readScalar(getReferenceValue(reference, referenceIdx, dli), type)) {
+            ++mismatchCount;
+        }
+    }
+    CHECK(mismatchCount == 0u);
+    free(values);
+}
+
+/* compares a list property of element, read with PlyExtractList, to the same property of reference */
+static void compareListProperty(const struct PlyElement* reference, const U32 referenceIdx, const struct PlyElement* element, const U32 propertyIdx)
+{
+    const struct PlyProperty* property = reference->properties + referenceIdx;
+    const U8 countSize = PlyGetSizeofScalarType(property->listCountType);
+    const U8 scalarSize = PlyGetSizeofScalarType(property->scalarType);
+    const U32 count = element->dataLineCount;
+    U64* offsets = (U64*)malloc(sizeof(U64) * (count + 1u));
+    CHECK(PlyExtractList(element, propertyIdx, PLY_SCALAR_TYPE_DOUBLE, offsets, NULL, 0u, 1u, false) == PLY_SUCCESS);
+    double* values = (double*)malloc(sizeof(double) * (offsets[count] + 1u));
+    CHECK(PlyExtractList(element, propertyIdx, PLY_SCALAR_TYPE_DOUBLE, offsets, values, offsets[count], 1u, false) == PLY_SUCCESS);
+
+    U32 mismatchCount = 0u;
+    U32 dli = 0u;
+    for (; dli < count; ++dli) {
+        const U8* list = getReferenceValue(reference, referenceIdx, dli);
+        const U64 listCount = (U64)readScalar(list, property->listCountType);
+        if (offsets[dli + 1u] - offsets[dli] != listCount) {
+            ++mismatchCount;
+            continue;
+        }
+        U64 li = 0u;
+        for (; li < listCount; ++li) {
+            if (values[offsets[dli] + li] != readScalar(list + countSize + li * scalarSize, property->scalarType)) {
+                ++mismatchCount;
+            }
+        }
+    }
+    CHECK(mismatchCount == 0u);
+    free(values);
+    free(offsets);
+}
+
+/* compares the properties element has to the same properties of reference, by name */
+static void compareElements(const struct PlyElement* reference, const struct PlyElement* element)
+{
+    CHECK(strcmp(reference->name, element->name) == 0);
+    CHECK(reference->dataLineCount == element->dataLineCount);
+    if (reference->dataLineCount != element->dataLineCount) {
+        return;
+    }
+
+    U32 pi = 0u;
+    for (; pi < element->propertyCount; ++pi) {
+        const struct PlyProperty* property = element->properties + pi;
+        const I64 ri = PlyGetPropertyIndexByName(reference, property->name);
+        CHECK(ri >= 0);
+        if (ri < 0) {
+            continue;
+        }
+        CHECK(property->dataType == reference->properties[ri].dataType);
+        CHECK(property->scalarType == reference->properties[ri].scalarType);
+        if (property->dataType == PLY_DATA_TYPE_SCALAR) {
+            compareScalarProperty(reference, (U32)ri, element, pi);
+        }
+        else {
+            compareListProperty(reference, (U32)ri, element, pi);
+        }
+    }
+}
+
+static void compareScenes(const struct PlyScene* reference, const struct PlyScene* scene)
+{
+    CHECK(reference->elementCount == scene->elementCount);
+    CHECK(reference->objectInfoCount == scene->objectInfoCount);
+    if (reference->elementCount != scene->elementCount) {
+        return;
+    }
+    U32 ei = 0u;
+    for (; ei < scene->elementCount; ++ei) {
+        const struct PlyNameHandle name = PlyInternName(reference->elements[ei].name);
+        CHECK(PlyGetElementIndexByName(scene, reference->elements[ei].name) == ei);
+        CHECK(PlyGetElementIndexByHandle(scene, &name) == ei);
+        CHECK(reference->elements[ei].propertyCount == scene->elements[ei].propertyCount);
+        compareElements(reference->elements + ei, scene->elements + ei);
+    }
+    CHECK(PlyGetElementIndexByName(scene, "no_such_element") == -1);
+}
+
+static void testLoadModes(void)
+{
+    U32 fi = 0u;
+    for (; fi < sizeof(testFiles) / sizeof(testFiles[0]); ++fi) {
+        struct PlyScene reference = { 0 };
+        struct PlyLoadInfo referenceInfo = { 0 };
+        CHECK(PlyLoadFromDisk(testFiles[fi], &reference, &referenceInfo) == PLY_SUCCESS);
+
+        U32 mi = 0u;
+        for (; mi < sizeof(loadModes) / sizeof(loadModes[0]); ++mi) {
+            struct PlyScene scene = { 0 };
+            struct PlyLoadInfo loadInfo = loadModes[mi];
+            const enum PlyResult r = PlyLoadFromDisk(testFiles[fi], &scene, &loadInfo);
+            CHECK(r == PLY_SUCCESS);
+            if (r == PLY_SUCCESS) {
+                compareScenes(&reference, &scene);
+            }
+            else {
+                printf("Loading %s with mode %u failed: %s\n", testFiles[fi], mi, PlyResultToString(r));
+            }
+            PlyDestroyScene(&scene);
+        }
+
+        /* borrowed memory must outlive the scene */
+        unsigned char* data;
+        size_t dataSize;
+        loadFile(testFiles[fi], &data, &dataSize);
+        struct PlyScene scene = { 0 };
+        struct PlyLoadInfo borrowInfo = { .borrowMemory = true };
+        CHECK(PlyLoadFromMemory(data, dataSize, &scene, &borrowInfo) == PLY_SUCCESS);
+        compareScenes(&reference, &scene);
+        PlyDestroyScene(&scene);
+        free(data);
+
+        PlyDestroyScene(&reference);
+    }
+}
+
+/* elements loaded with compactDataLines have no offset tables to write through */
+static void testCompactElementIsNotWritable(void)
+{
+    struct PlyScene scene = { 0 };
+    struct PlyLoadInfo loadInfo = { .compactDataLines = true };
+    CHECK(PlyLoadFromDisk("res/cube.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    CHECK(scene.elementCount == 2);
+    if (scene.elementCount == 2) {
+        const I32 indices[3] = { 0, 1, 2 };
+        CHECK(PlyWriteData(scene.elements, 0u, 0u, (union PlyScalarUnion) { .f32 = 1.0f }) == PLY_GENERIC_ERROR);
+        CHECK(PlyWriteDataList(scene.elements + 1, 0u, 0u, 3u, indices) == PLY_GENERIC_ERROR);
+        CHECK(scene.elements[0].dataSize == 8u * 3u * 4u);
+    }
+    PlyDestroyScene(&scene);
+}
+
+static void testUniformListArity(void)
+{
+    struct PlyScene scene = { 0 };
+    struct PlyLoadInfo loadInfo = { 0 };
+    CHECK(PlyLoadFromDisk("res/cube_bin.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    CHECK(scene.elementCount == 2);
+    if (scene.elementCount == 2) {
+        const struct PlyElement* face = scene.elements + 1;
+        CHECK(face->properties[0].listArity == 4u);
+        CHECK(!face->properties[0].denseList);
+        CHECK(face->dataLineStride == 1u + 4u * 4u);
+    }
+    PlyDestroyScene(&scene);
+
+    /* the counts are dropped, so the element is an index buffer */
+    loadInfo.denseLists = true;
+    CHECK(PlyLoadFromDisk("res/cube_bin.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    CHECK(scene.elementCount == 2);
+    if (scene.elementCount == 2) {
+        const struct PlyElement* face = scene.elements + 1;
+        CHECK(face->properties[0].listArity == 4u);
+        CHECK(face->properties[0].denseList);
+        CHECK(face->dataLineStride == 4u * 4u);
+        CHECK(face->dataSize == 6u * 4u * 4u);
+    }
+    PlyDestroyScene(&scene);
+}
+
+/* loads size bytes of text from a buffer of exactly that size, so reading past the end is caught by the debug heap or a sanitizer */
+static enum PlyResult loadExactBytes(const void* bytes, const size_t size, struct PlyScene* scene, struct PlyLoadInfo* loadInfo)
+{
+    U8* data = (U8*)malloc(size);
+    memcpy(data, bytes, size);
+    const enum PlyResult r = PlyLoadFromMemory(data, size, scene, loadInfo);
+    free(data);
+    return r;
+}
+
+static enum PlyResult loadExactBuffer(const char* text, struct PlyScene* scene, struct PlyLoadInfo* loadInfo)
+{
+    return loadExactBytes(text, strlen(text), scene, loadInfo);
+}
+
+/* the last value of an ASCII file may end the data without a newline */
+static void testAsciiWithoutTrailingNewline(void)
+{
+    const char* floatText = "ply\nformat ascii 1.0\nelement vertex 2\nproperty float x\nproperty float y\nend_header\n1 2.5\n3.5 4.25";
+    const char* doubleText = "ply\nformat ascii 1.0\nelement vertex 2\nproperty double x\nproperty double y\nend_header\n1 2.5\n3.5 4.25e1";
+    const char* texts[] = { floatText, doubleText };
+    U32 ti = 0u;
+    for (; ti < 2u; ++ti) {
+        struct PlyScene scene = { 0 };
+        struct PlyLoadInfo loadInfo = { 0 };
+        CHECK(loadExactBuffer(texts[ti], &scene, &loadInfo) == PLY_SUCCESS);
+        CHECK(scene.elementCount == 1u);
+        if (scene.elementCount == 1u) {
+            double y[2] = { 0.0, 0.0 };
+            CHECK(PlyExtractColumn(scene.elements, 1u, PLY_SCALAR_TYPE_DOUBLE, y, 0u, 2u, false) == PLY_SUCCESS);
+            CHECK(y[0] == 2.5);
+            CHECK(y[1] == (ti == 0u ? 4.25 : 42.5));
+        }
+        PlyDestroyScene(&scene);
+    }
+}
+
+/* a header that ends in the middle of a line must fail to load without reading past the buffer */
+static void testTruncatedHeader(void)
+{
+    const char* header = "ply\nformat binary_little_endian 1.0\ncomment truncated\nobj_info answer 42\nelement face 2\nproperty list uchar int vertex_indices\nend_header\n";
+    const size_t headerLen = strlen(header);
+    char text[256];
+    size_t len = 1u;
+    for (; len < headerLen; ++len) {
+        memcpy(text, header, len);
+        text[len] = '\0';
+        struct PlyScene scene = { 0 };
+        struct PlyLoadInfo loadInfo = { .saveComments = true };
+        CHECK(loadExactBuffer(text, &scene, &loadInfo) != PLY_SUCCESS || scene.elementCount == 0u);
+        PlyDestroyScene(&scene);
+    }
+
+    /* types and keywords must match as a whole */
+    const char* prefixes[] = {
+        "ply\nformat ascii 1.0\nelement vertex 1\nproperty flo x\nend_header\n1\n",
+        "ply\nformat ascii 1.0\nelement vertex 1\nproperty floats x\nend_header\n1\n",
+        "ply\nformat ascii 1.0\nelement face 1\nproperty list u int vertex_indices\nend_header\n1 1\n",
+        "ply\nformat ascii 1.0\nelement face 1\nproperty list uchar\nend_header\n1 1\n",
+        "ply\nformat ascii 1.0\nelement face 1\nproperty list uchar int\nend_header\n1 1\n"
+    };
+    U32 i = 0u;
+    for (; i < sizeof(prefixes) / sizeof(prefixes[0]); ++i) {
+        struct PlyScene scene = { 0 };
+        struct PlyLoadInfo loadInfo = { 0 };
+        CHECK(loadExactBuffer(prefixes[i], &scene, &loadInfo) != PLY_SUCCESS);
+        PlyDestroyScene(&scene);
+    }
+}
+
+static void testElementSelection(void)
+{
+    struct PlyScene reference = { 0 };
+    struct PlyLoadInfo referenceInfo = { 0 };
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &reference, &referenceInfo) == PLY_SUCCESS);
+    if (reference.elementCount != 2) {
+        PlyDestroyScene(&reference);
+        return;
+    }
+
+    /* only the faces, the vertices in front of them are skipped */
+    const char* elements[] = { "face" };
+    struct PlyScene scene = { 0 };
+    struct PlyLoadInfo loadInfo = { .elements = elements, .elementCount = 1u };
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    CHECK(scene.elementCount == 1u);
+    CHECK(PlyGetElementIndexByName(&scene, "vertex") == -1);
+    CHECK(PlyGetElementIndexByName(&scene, "face") == 0);
+    if (scene.elementCount == 1u) {
+        compareElements(reference.elements + 1, scene.elements);
+    }
+    PlyDestroyScene(&scene);
+
+    /* the same in parallel */
+    loadInfo.threadCount = 4u;
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    CHECK(scene.elementCount == 1u);
+    if (scene.elementCount == 1u) {
+        compareElements(reference.elements + 1, scene.elements);
+    }
+    PlyDestroyScene(&scene);
+
+    PlyDestroyScene(&reference);
+}
+
+static void testPropertySelection(void)
+{
+    struct PlyScene reference = { 0 };
+    struct PlyLoadInfo referenceInfo = { 0 };
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &reference, &referenceInfo) == PLY_SUCCESS);
+    if (reference.elementCount != 2) {
+        PlyDestroyScene(&reference);
+        return;
+    }
+
+    /* x and z of the vertices, every property of the faces */
+    const char* properties[] = { "z", "x" };
+    struct PlyPropertySelection selection = { .element = "vertex", .properties = properties, .propertyCount = 2u };
+    struct PlyScene scene = { 0 };
+    struct PlyLoadInfo selectInfo = { .propertySelections = &selection, .propertySelectionCount = 1u };
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &scene, &selectInfo) == PLY_SUCCESS);
+    CHECK(scene.elementCount == 2u);
+    if (scene.elementCount == 2u) {
+        const struct PlyElement* vertex = scene.elements;
+        CHECK(vertex->propertyCount == 2u);
+        CHECK(PlyGetPropertyIndexByName(vertex, "x") >= 0);
+        CHECK(PlyGetPropertyIndexByName(vertex, "z") >= 0);
+        CHECK(PlyGetPropertyIndexByName(vertex, "y") == -1);
+        CHECK(PlyGetPropertyIndexByName(vertex, "confidence") == -1);
+        compareElements(reference.elements, vertex);
+        compareElements(reference.elements + 1, scene.elements + 1);
+    }
+    PlyDestroyScene(&scene);
+
+    /* together with an element selection, in parallel */
+    const char* elements[] = { "vertex" };
+    selectInfo.elements = elements;
+    selectInfo.elementCount = 1u;
+    selectInfo.threadCount = 4u;
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &scene, &selectInfo) == PLY_SUCCESS);
+    CHECK(scene.elementCount == 1u);
+    if (scene.elementCount == 1u) {
+        CHECK(scene.elements[0].propertyCount == 2u);
+        compareElements(reference.elements, scene.elements);
+    }
+    PlyDestroyScene(&scene);
+
+    PlyDestroyScene(&reference);
+}
+
+/* a list column at the start of the column block whose lists are all empty */
+static void testColumnarEmptyLists(void)
+{
+    const char asciiText[] = "ply\nformat ascii 1.0\nelement face 2\nproperty list uchar int vertex_indices\nend_header\n0\n0\n";
+    const char binaryText[] = "ply\nformat binary_little_endian 1.0\nelement face 2\nproperty list uchar int vertex_indices\nend_header\n\0\0";
+    const char* texts[] = { asciiText, binaryText };
+    const size_t sizes[] = { sizeof(asciiText) - 1u, sizeof(binaryText) - 1u };
+    U32 ti = 0u;
+    for (; ti < 2u; ++ti) {
+        struct PlyScene scene = { 0 };
+        struct PlyLoadInfo loadInfo = { .columnarData = true };
+        CHECK(loadExactBytes(texts[ti], sizes[ti], &scene, &loadInfo) == PLY_SUCCESS);
+        CHECK(scene.elementCount == 1u);
+        if (scene.elementCount == 1u) {
+            const struct PlyProperty* property = scene.elements[0].properties;
+            CHECK(property->listOffsets != NULL);
+            if (property->listOffsets) {
+                CHECK(property->listOffsets[0] == 0u && property->listOffsets[1] == 0u && property->listOffsets[2] == 0u);
+            }
+            U64 offsets[3] = { 7u, 7u, 7u };
+            I32 value = 0;
+            CHECK(PlyExtractList(scene.elements, 0u, PLY_SCALAR_TYPE_INT, offsets, &value, 1u, 1u, 0) == PLY_SUCCESS);
+            CHECK(offsets[0] == 0u && offsets[1] == 0u && offsets[2] == 0u);
+        }
+        PlyDestroyScene(&scene);
+    }
+}
+
+struct TestVertex
+{
+    float position[3];
+    U8 confidence;
+    U8 padding[3];
+};
+
+static void testElementBindings(void)
+{
+    struct PlyScene reference = { 0 };
+    struct PlyLoadInfo referenceInfo = { 0 };
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &reference, &referenceInfo) == PLY_SUCCESS);
+    if (reference.elementCount != 2) {
+        PlyDestroyScene(&reference);
+        return;
+    }
+    const struct PlyElement* referenceVertex = reference.elements;
+    const U32 vertexCount = referenceVertex->dataLineCount;
+
+    const struct PlyPropertyBinding properties[] = {
+        { .property = "x", .offset = 0u, .stride = sizeof(struct TestVertex), .type = PLY_SCALAR_TYPE_FLOAT },
+        { .property = "y", .offset = 4u, .stride = sizeof(struct TestVertex), .type = PLY_SCALAR_TYPE_FLOAT },
+        { .property = "z", .offset = 8u, .stride = sizeof(struct TestVertex), .type = PLY_SCALAR_TYPE_FLOAT },
+        { .property = "confidence", .offset = 12u, .stride = sizeof(struct TestVertex), .type = PLY_SCALAR_TYPE_UCHAR, .normalized = true },
+        { .property = "nx", .offset = 0u, .stride = sizeof(struct TestVertex), .type = PLY_SCALAR_TYPE_FLOAT }
+    };
+    struct TestVertex* vertices = (struct TestVertex*)calloc(vertexCount, sizeof(struct TestVertex));
+    struct PlyElementBinding binding = { .element = "vertex", .properties = properties, .propertyCount = 5u, .dst = vertices, .dataLineCapacity = vertexCount };
+
+    U32 ti = 0u;
+    for (; ti < 2u; ++ti) {
+        /* once on the calling thread, once in parallel */
+        struct PlyScene scene = { 0 };
+        struct PlyLoadInfo loadInfo = { .elementBindings = &binding, .elementBindingCount = 1u, .threadCount = ti == 0u ? 0u : 4u };
+        memset(vertices, 0, sizeof(struct TestVertex) * vertexCount);
+        CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &scene, &loadInfo) == PLY_SUCCESS);
+        CHECK(scene.elementCount == 2u);
+        if (scene.elementCount == 2u) {
+            CHECK(scene.elements[0].dataLineCount == vertexCount);
+            CHECK(scene.elements[0].data == NULL);
+            compareElements(reference.elements + 1, scene.elements + 1);
+        }
+        PlyDestroyScene(&scene);
+
+        float* column = (float*)malloc(sizeof(float) * vertexCount);
+        U8* confidence = (U8*)malloc(vertexCount);
+        CHECK(PlyExtractColumn(referenceVertex, (U32)PlyGetPropertyIndexByName(referenceVertex, "confidence"), PLY_SCALAR_TYPE_UCHAR, confidence, 0u, vertexCount, true) == PLY_SUCCESS);
+        U32 mismatchCount = 0u;
+        U32 ci = 0u;
+        for (; ci < 3u; ++ci) {
+            CHECK(PlyExtractColumn(referenceVertex, ci, PLY_SCALAR_TYPE_FLOAT, column, 0u, vertexCount, false) == PLY_SUCCESS);
+            U32 vi = 0u;
+            for (; vi < vertexCount; ++vi) {
+                mismatchCount += vertices[vi].position[ci] != column[vi];
+            }
+        }
+        U32 vi = 0u;
+        for (; vi < vertexCount; ++vi) {
+            mismatchCount += vertices[vi].confidence != confidence[vi];
+            mismatchCount += vertices[vi].padding[0] != 0u;
+        }
+        CHECK(mismatchCount == 0u);
+        free(confidence);
+        free(column);
+    }
+
+    /* a buffer that is too small */
+    struct PlyScene scene = { 0 };
+    binding.dataLineCapacity = vertexCount - 1u;
+    struct PlyLoadInfo loadInfo = { .elementBindings = &binding, .elementBindingCount = 1u };
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &scene, &loadInfo) == PLY_EXCEEDS_BOUND_LIMITS_ERROR);
+    PlyDestroyScene(&scene);
+
+    free(vertices);
+    PlyDestroyScene(&reference);
+}
+
+static void testExtractColumn(void)
+{
+    struct PlyScene scene = { 0 };
+    struct PlyLoadInfo loadInfo = { 0 };
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    if (scene.elementCount != 2) {
+        PlyDestroyScene(&scene);
+        return;
+    }
+    const struct PlyElement* vertex = scene.elements;
+    const struct PlyElement* face = scene.elements + 1;
+
+    /* a range of rows, converted */
+    double x64[100];
+    float x32[100];
+    CHECK(PlyExtractColumn(vertex, 0u, PLY_SCALAR_TYPE_DOUBLE, x64, 1000u, 100u, false) == PLY_SUCCESS);
+    CHECK(PlyExtractColumn(vertex, 0u, PLY_SCALAR_TYPE_FLOAT, x32, 1000u, 100u, false) == PLY_SUCCESS);
+    U32 mismatchCount = 0u;
+    U32 i = 0u;
+    for (; i < 100u; ++i) {
+        mismatchCount += x64[i] != readScalar(getReferenceValue(vertex, 0u, 1000u + i), PLY_SCALAR_TYPE_FLOAT);
+        mismatchCount += (double)x32[i] != x64[i];
+    }
+    CHECK(mismatchCount == 0u);
+    CHECK(PlyExtractColumn(vertex, 0u, PLY_SCALAR_TYPE_FLOAT, x32, vertex->dataLineCount - 10u, 100u, false) == PLY_EXCEEDS_BOUND_LIMITS_ERROR);
+    CHECK(PlyExtractColumn(face, 0u, PLY_SCALAR_TYPE_FLOAT, x32, 0u, 100u, false) != PLY_SUCCESS);
+
+    PlyDestroyScene(&scene);
+}
+
+static void testExtractList(void)
+{
+    struct PlyScene scene = { 0 };
+    struct PlyLoadInfo loadInfo = { 0 };
+    CHECK(PlyLoadFromDisk("res/bun_zipper.ply", &scene, &loadInfo) == PLY_SUCCESS);
+    if (scene.elementCount != 2) {
+        PlyDestroyScene(&scene);
+        return;
+    }
+    const struct PlyElement* vertex = scene.elements;
+    const struct PlyElement* face = scene.elements + 1;
+
+    /* the same lists on one and on several threads */
+    const U32 faceCount = face->dataLineCount;
+    U64* offsets = (U64*)malloc(sizeof(U64) * (faceCount + 1u));
+    U64* threadedOffsets = (U64*)malloc(sizeof(U64) * (faceCount + 1u));
+    CHECK(PlyExtractList(face, 0u, PLY_SCALAR_TYPE_UINT, offsets, NULL, 0u, 1u, false) == PLY_SUCCESS);
+    CHECK(offsets[0] == 0u);
+    CHECK(offsets[faceCount] == (U64)faceCount * 3u);
+    U32* indices = (U32*)malloc(sizeof(U32) * offsets[faceCount]);
+    U32* threadedIndices = (U32*)malloc(sizeof(U32) * offsets[faceCount]);
+    CHECK(PlyExtractList(face, 0u, PLY_SCALAR_TYPE_UINT, offsets, indices, offsets[faceCount] - 1u, 1u, false) == PLY_EXCEEDS_BOUND_LIMITS_ERROR);
+    CHECK(PlyExtractList(face, 0u, PLY_SCALAR_TYPE_UINT, offsets, indices, offsets[faceCount], 1u, false) == PLY_SUCCESS);
+    CHECK(PlyExtractList(face, 0u, PLY_SCALAR_TYPE_UINT, threadedOffsets, threadedIndices, offsets[faceCount], 4u, false) == PLY_SUCCESS);
+    CHECK(memcmp(offsets, threadedOffsets, sizeof(U64) * (faceCount + 1u)) == 0);
+    CHECK(memcmp(indices, threadedIndices, sizeof(U32) * offsets[faceCount]) == 0);
+    U32 mismatchCount = 0u;
+    U32 i = 0u;
+    for (; i < offsets[faceCount]; ++i) {
+        mismatchCount += indices[i] >= vertex->dataLineCount;
+    }
+    CHECK(mismatchCount == 0u);
+    CHECK(PlyExtractList(vertex, 0u, PLY_SCALAR_TYPE_UINT, offsets, NULL, 0u, 1u, false) != PLY_SUCCESS);
+    free(threadedIndices);
+    free(indices);
+    free(threadedOffsets);
+    free(offsets);
+
+    PlyDestroyScene(&scene);
+}
+
+
+/* an element without data lines has a single offset, whatever mode it was loaded with */
+static void testExtractEmptyList(void)
+{
+    const char* text = "ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nelement face 0\nproperty list uchar int vertex_indices\nend_header\n1\n";
+    const struct PlyLoadInfo modes[] = { { 0 }, { .compactDataLines = true }, { .columnarData = true } };
+    U32 mi = 0u;
+    for (; mi < sizeof(modes) / sizeof(modes[0]); ++mi) {
+        struct PlyScene scene = { 0 };
+        struct PlyLoadInfo loadInfo = modes[mi];
+        CHECK(loadExactBuffer(text, &scene, &loadInfo) == PLY_SUCCESS);
+        const I64 faceIdx = PlyGetElementIndexByName(&scene, "face");
+        CHECK(faceIdx >= 0);
+        if (faceIdx >= 0) {
+            U64 offsets[1] = { 7u };
+            I32 value = 0;
+            CHECK(PlyExtractList(scene.elements + faceIdx, 0u, PLY_SCALAR_TYPE_INT, offsets, &value, 1u, 1u, false) == PLY_SUCCESS);
+            CHECK(offsets[0] == 0u);
+        }
+        PlyDestroyScene(&scene);
+    }
+
+    /* an element that is being built for writing has neither data nor columns yet */
+    struct PlyProperty property = { 0 };
+    property.dataType = PLY_DATA_TYPE_LIST;
+    property.scalarType = PLY_SCALAR_TYPE_INT;
+    property.listCountType = PLY_SCALAR_TYPE_UCHAR;
+    struct PlyElement element = { 0 };
+    element.properties = &property;
+    element.propertyCount = 1u;
+    U64 offsets[1] = { 7u };
+    CHECK(PlyExtractList(&element, 0u, PLY_SCALAR_TYPE_INT, offsets, NULL, 0u, 1u, false) == PLY_SUCCESS);
+    CHECK(offsets[0] == 0u);
+}
+
+static void testWriteByHandle(void)
+{
+    struct PlyScene scene = { .format = PLY_FORMAT_ASCII };
+    struct PlyElement vertex = { .name = "vertex" };
+    struct PlyProperty x = { .name = "x", .dataType = PLY_DATA_TYPE_SCALAR, .scalarType = PLY_SCALAR_TYPE_FLOAT };
+    struct PlyProperty y = { .name = "y", .dataType = PLY_DATA_TYPE_SCALAR, .scalarType = PLY_SCALAR_TYPE_FLOAT };
+    CHECK(PlyWriteProperty(&vertex, &x) == PLY_SUCCESS);
+    CHECK(PlyWriteProperty(&vertex, &y) == PLY_SUCCESS);
+    CHECK(PlyWriteProperty(&vertex, &x) == PLY_GENERIC_ERROR);
+    CHECK(PlyCreateDataLines(&vertex, 4u) == PLY_SUCCESS);
+
+    const struct PlyNameHandle xName = PlyInternName("x");
+    const struct PlyNameHandle yName = PlyInternName("y");
+    const struct PlyNameHandle wName = PlyInternName("w");
+    CHECK(PlyGetPropertyIndexByHandle(&vertex, &xName) == 0);
+    CHECK(PlyGetPropertyIndexByHandle(&vertex, &yName) == 1);
+    CHECK(PlyGetPropertyIndexByHandle(&vertex, &wName) == -1);
+    U32 i = 0u;
+    for (; i < vertex.dataLineCount; ++i) {
+        CHECK(PlyWriteDataByHandle(&vertex, i, &xName, (union PlyScalarUnion) { .f32 = (float)i }) == PLY_SUCCESS);
+        CHECK(PlyWriteDataByName(&vertex, i, "y", (union PlyScalarUnion) { .f32 = (float)i * 2.0f }) == PLY_SUCCESS);
+    }
+    CHECK(PlyWriteDataByHandle(&vertex, 0u, &wName, (union PlyScalarUnion) { .f32 = 1.0f }) == PLY_GENERIC_ERROR);
+
+    CHECK(PlyWriteElement(&scene, &vertex) == PLY_SUCCESS);
+    CHECK(PlyWriteElement(&scene, &vertex) == PLY_GENERIC_ERROR);
+    CHECK(PlyGetElementIndexByName(&scene, "vertex") == 0);
+    if (scene.elementCount == 1u) {
+        float values[4];
+        CHECK(PlyExtractColumn(scene.elements, 1u, PLY_SCALAR_TYPE_FLOAT, values, 0u, 4u, false) == PLY_SUCCESS);
+        CHECK(values[0] == 0.0f && values[1] == 2.0f && values[2] == 4.0f && values[3] == 6.0f);
+        /* PlyDestroyScene only frees the shared element data of loaded scenes */
+        free(scene.elements[0].data);
+        scene.elements[0].data = NULL;
+    }
+    PlyDestroyScene(&scene);
+}
+
+int main(void)
+{
+#ifndef NDEBUG
+    _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif /* !NDEBUG */
+
+    testObjectInfos();
+    testArenaSceneIsReadOnly();
+    testRenamedElementLookup();
+    testLoadModes();
+    testCompactElementIsNotWritable();
+    testUniformListArity();
+    testAsciiWithoutTrailingNewline();
+    testTruncatedHeader();
+    testElementSelection();
+    testPropertySelection();
+    testColumnarEmptyLists();
+    testElementBindings();
+    testExtractColumn();
+    testExtractList();
+    testExtractEmptyList();
+    testWriteByHandle();
+
+    if (failedCheckCount != 0) {
+        printf("%d checks failed.\n", failedCheckCount);
+        printf("Hint: ensure that the working directory is /Tests\n");
+        return EXIT_FAILURE;
+    }
+    printf("All checks passed.\n");
+    return EXIT_SUCCESS;
+}
@@ -3,21 +3,18 @@
 #include <io.h>
 #include <assert.h>
 
-double getDataFromPropertyOfElement(const struct PlyElement* e, const struct PlyProperty* prop, const U64 dataLineIdx, U8* success)
+double getDataFromPropertyOfElement(const struct PlyElement* e, const U32 propertyIdx, const U32 dataLineIdx, U8* success)
 {
-    const U64 lineBegin = e->dataLineBegins[dataLineIdx];
-    const U32 dataOffset = prop->dataLineOffsets[dataLineIdx];
-    const U64 offset = lineBegin + dataOffset;
-    if (offset >= e->dataSize || dataLineIdx >= e->dataLineCount) {
+    if (dataLineIdx >= e->dataLineCount || propertyIdx >= e->propertyCount) {
         if (success)
             *success = 0;
         return 0;
     }
 
-    U8* f = ((U8*)e->data) + offset;
+    const U8* f = (const U8*)PlyGetPropertyData(e, propertyIdx, dataLineIdx);
     if (success)
         *success = 1;
-    return PlyScaleBytesToD64(f, prop->scalarType);
+    return PlyScaleBytesToD64(f, e->properties[propertyIdx].scalarType);
 }
 
 
@@ -25,7 +22,7 @@ void getDataFromPropertyOfElementAsList(double* dstBuffer, const size_t dstBuffe
     const struct PlyElement* e, const struct PlyProperty* prop, const U64 dataLineIdx, U8* success)
 {
 
-    U64 offset = e->dataLineBegins[dataLineIdx] + prop->dataLineOffsets[dataLineIdx];
+    U64 offset = (U8*)PlyGetPropertyData(e, (U32)PlyGetPropertyIndex(e, prop), (U32)dataLineIdx) - (U8*)e->data;
     if (offset >= e->dataSize) { /* check for out of bounds read */
         if (success)
             *success = 0;
@@ -135,7 +132,7 @@ void printSceneData(struct PlyScene* scene, char printSceneHeader, char printEle
                             }
                         }
                         else {
-                            double d = getDataFromPropertyOfElement(element, property, lno, &success);
+                            double d = getDataFromPropertyOfElement(element, (U32)pId, (U32)lno, &success);
                             if (!success) {
                                 assert(00 && "Bad data read.");
                             }
@@ -15,12 +15,78 @@ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY
 TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+#define PLY_USE_MMAP 1
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE /* mmap(), madvise() and MAP_ANONYMOUS */
+#endif
+#else
+#define PLY_USE_MMAP 0
+#endif
+
 #include "c_polygon.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <ctype.h>
 #include <assert.h>
 #include <errno.h>
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+
+#if PLY_USE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif /* PLY_USE_MMAP */
+
+#if !defined(PLY_NO_THREADS)
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif /* !PLY_NO_THREADS */
+
+/* 1 if float and double arithmetic is evaluated in its own precision, which the fast float parsing path relies on.
+x87 code keeps extra precision and rounds twice, so this is only assumed from a positive signal */
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0) || (defined(__FLT_EVAL_METHOD__) && __FLT_EVAL_METHOD__ == 0) || defined(_M_X64) || defined(__SSE2_MATH__)
+#define PLY_EXACT_FLOAT_EVAL 1
+#else
+#define PLY_EXACT_FLOAT_EVAL 0
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLY_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define PLY_USE_SSE2 0
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+#define PLY_USE_SSSE3 1
+#include <immintrin.h>
+#else
+#define PLY_USE_SSSE3 0
+#endif
+#if defined(__AVX2__)
+#define PLY_USE_AVX2 1
+#else
+#define PLY_USE_AVX2 0
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 #ifdef __cplusplus
 namespace cply
@@ -29,36 +95,25 @@ namespace cply
 
 #include "c_polygon.inl"
 
-
-
-
-    /*returns true if collision*/
-bool PLY_INLINE checkForElementNameCollision(const struct PlyScene* scene, const char* name)
+/* index of the lowest set bit, x must not be 0 */
+PLY_INLINE U32 plyCtz64(const U64 x)
 {
-    U32 ei = 0;
-    for (; ei < scene->elementCount; ++ei)
-    {
-        if (streql(scene->elements[ei].name, name) == true)
-        {
-            return true;
-        }
-    }
-    return false;
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return (U32)idx;
+#elif defined(__GNUC__)
+    return (U32)__builtin_ctzll(x);
+#else
+    U32 idx = 0u;
+    while (((x >> idx) & 1u) == 0u) {
+        ++idx;
+    }
+    return idx;
+#endif
 }
 
-/*returns true if collision*/
-bool PLY_INLINE checkForPropertyNameCollision(const struct PlyElement* element, const char* name)
-{
-    U32 ei = 0;
-    for (; ei < element->propertyCount; ++ei)
-    {
-        if (streql(element->properties[ei].name, name) == true)
-        {
-            return true;
-        }
-    }
-    return false;
-}
+
 
 
 static void dtoa_s(double x, uint16_t decimalPlaces, char* buff, const U16 buffSize) {
@@ -210,67 +265,382 @@ void PlySetCustomDeallocator(PlyDeallocT deA)
     plyDealloc = deA;
 }
 
+/* number of PlyElementSetName calls, a scene's element name table that was filled before the last one may be stale */
+static U32 plyElementRenameCount = 0u;
+
+/* FNV-1a hash of a name */
+PLY_INLINE U32 hashName(const char* name)
+{
+    U32 hash = 2166136261u;
+    for (; *name != '\0'; ++name) {
+        hash = (hash ^ (U8)*name) * 16777619u;
+    }
+    return hash;
+}
+
+/* adds the name at index to the table, which grows to keep at least half of its slots empty.
+Names must be added in order, so if one could not be added the table stops growing and the lookups fall back to comparing every name. */
+static void addToNameTable(struct PlyNameTable* table, const U32 hash, const U32 index)
+{
+    if (table->count != index) {
+        return;
+    }
+    if ((U64)table->count * 2u + 2u > table->capacity)
+    {
+        if (table->capacity >= 0x80000000u) {
+            return;
+        }
+        const U32 capacity = table->capacity != 0u ? table->capacity * 2u : 16u;
+        struct PlyNameSlot* slots = (struct PlyNameSlot*)plyReCalloc(NULL, 0u, capacity, sizeof(struct PlyNameSlot));
+        if (!slots) {
+            return;
+        }
+        U32 si = 0u;
+        for (; si < table->capacity; ++si) {
+            const struct PlyNameSlot* old = table->slots + si;
+            if (old->index == 0u) {
+                continue;
+            }
+            U32 i = old->hash & (capacity - 1u);
+            while (slots[i].index != 0u) {
+                i = (i + 1u) & (capacity - 1u);
+            }
+            slots[i] = *old;
+        }
+        if (table->slots) {
+            plyDealloc(table->slots);
+        }
+        table->slots = slots;
+        table->capacity = capacity;
+    }
+
+    U32 i = hash & (table->capacity - 1u);
+    while (table->slots[i].index != 0u) {
+        i = (i + 1u) & (table->capacity - 1u);
+    }
+    table->slots[i].hash = hash;
+    table->slots[i].index = index + 1u;
+    ++table->count;
+}
+
+/* refills the table with the count names that are nameStride bytes apart, such as the names of an element's properties */
+static void rebuildNameTable(struct PlyNameTable* table, const char* names, const U64 nameStride, const U32 count)
+{
+    if (table->slots) {
+        memset(table->slots, 0, (U64)table->capacity * sizeof(struct PlyNameSlot));
+    }
+    table->count = 0u;
+    U32 i = 0u;
+    for (; i < count; ++i) {
+        addToNameTable(table, hashName(names + i * nameStride), i);
+    }
+}
+
+/* returns the index of name among the count names that are nameStride bytes apart, or -1 */
+PLY_INLINE I64 scanNames(const char* names, const U64 nameStride, const U32 count, const char* name)
+{
+    U32 i = 0u;
+    for (; i < count; ++i) {
+        if (streql(names + (U64)i * nameStride, name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* returns the index of name among the count names that are nameStride bytes apart, or -1 */
+static I64 findName(const struct PlyNameTable* table, const char* names, const U64 nameStride, const U32 count, const char* name, const U32 hash)
+{
+    if (table->count == count && table->capacity != 0u)
+    {
+        U32 i = hash & (table->capacity - 1u);
+        for (; table->slots[i].index != 0u; i = (i + 1u) & (table->capacity - 1u)) {
+            const struct PlyNameSlot* slot = table->slots + i;
+            if (slot->hash == hash && streql(names + (U64)(slot->index - 1u) * nameStride, name)) {
+                return slot->index - 1u;
+            }
+        }
+        return -1;
+    }
+    return scanNames(names, nameStride, count, name);
+}
+
+/* refills a scene's element names if an element was renamed since they were added, which PlyElementSetName can not do because it does not know the scene */
+static void refreshElementNames(struct PlyScene* scene)
+{
+    if (scene->elementNames.renameCount != plyElementRenameCount) {
+        rebuildNameTable(&scene->elementNames, (const char*)scene->elements, sizeof(struct PlyElement), scene->elementCount);
+        scene->elementNames.renameCount = plyElementRenameCount;
+    }
+}
+
+PLY_INLINE I64 findElementName(const struct PlyScene* scene, const char* name, const U32 hash)
+{
+    if (scene->elementNames.renameCount != plyElementRenameCount) {
+        return scanNames((const char*)scene->elements, sizeof(struct PlyElement), scene->elementCount, name);
+    }
+    return findName(&scene->elementNames, (const char*)scene->elements, sizeof(struct PlyElement), scene->elementCount, name, hash);
+}
+
+PLY_INLINE I64 findPropertyName(const struct PlyElement* element, const char* name, const U32 hash)
+{
+    return findName(&element->propertyNames, (const char*)element->properties, sizeof(struct PlyProperty), element->propertyCount, name, hash);
+}
+
+    /*returns true if collision*/
+bool PLY_INLINE checkForElementNameCollision(const struct PlyScene* scene, const char* name)
+{
+    return findElementName(scene, name, hashName(name)) >= 0;
+}
+
+/*returns true if collision*/
+bool PLY_INLINE checkForPropertyNameCollision(const struct PlyElement* element, const char* name)
+{
+    return findPropertyName(element, name, hashName(name)) >= 0;
+}
+
+/* a block of a scene arena, its memory follows the header */
+struct PlyArenaBlock
+{
+    struct PlyArenaBlock* next;
+    U64 size;
+    U64 used;
+};
+
+#define PLY_ARENA_ALIGNMENT 16u
+#define PLY_MIN_ARENA_BLOCK_SIZE ((U64)1u << 16u)
+
+PLY_INLINE U64 alignArenaSize(const U64 size)
+{
+    return (size + PLY_ARENA_ALIGNMENT - 1u) & ~(U64)(PLY_ARENA_ALIGNMENT - 1u);
+}
+
+/* adds a block with room for at least size bytes to the front of the scene's arena */
+static struct PlyArenaBlock* addArenaBlock(struct PlyScene* scene, U64 size)
+{
+    const struct PlyArenaBlock* last = (const struct PlyArenaBlock*)scene->arena;
+    if (last && size < last->size * 2u) {
+        size = last->size * 2u;
+    }
+    if (size < PLY_MIN_ARENA_BLOCK_SIZE) {
+        size = PLY_MIN_ARENA_BLOCK_SIZE;
+    }
+    struct PlyArenaBlock* block = (struct PlyArenaBlock*)plyRealloc(NULL, alignArenaSize(sizeof(struct PlyArenaBlock)) + size);
+    if (!block) {
+        return NULL;
+    }
+    block->next = (struct PlyArenaBlock*)scene->arena;
+    block->size = size;
+    block->used = 0u;
+    scene->arena = block;
+    return block;
+}
+
+/* returns size zeroed bytes from the scene's arena */
+static void* arenaAlloc(struct PlyScene* scene, const U64 size)
+{
+    const U64 alignedSize = alignArenaSize(size);
+    struct PlyArenaBlock* block = (struct PlyArenaBlock*)scene->arena;
+    if (!block || block->size - block->used < alignedSize) {
+        block = addArenaBlock(scene, alignedSize);
+        if (!block) {
+            return NULL;
+        }
+    }
+    U8* mem = (U8*)block + alignArenaSize(sizeof(struct PlyArenaBlock)) + block->used;
+    block->used += alignedSize;
+    memset(mem, 0, size);
+    return mem;
+}
+
+static void releaseArena(void* arena)
+{
+    struct PlyArenaBlock* block = (struct PlyArenaBlock*)arena;
+    while (block) {
+        struct PlyArenaBlock* next = block->next;
+        plyDealloc(block);
+        block = next;
+    }
+}
+
+/* allocates count zeroed values of size bytes that belong to the scene, from its arena if it has one. scene may be NULL */
+static void* sceneCalloc(struct PlyScene* scene, const U64 count, const U64 size)
+{
+    if (count == 0u || size == 0u) {
+        return NULL;
+    }
+    if (scene && scene->arena) {
+        if (count > UINT64_MAX / size) {
+            return NULL;
+        }
+        return arenaAlloc(scene, count * size);
+    }
+    if (count > UINT32_MAX || size > UINT32_MAX) {
+        return NULL;
+    }
+    return plyReCalloc(NULL, 0u, (U32)count, (U32)size);
+}
+
+/* frees memory from sceneCalloc, memory in an arena is only released with the whole scene */
+PLY_INLINE void sceneDealloc(const struct PlyScene* scene, void* mem)
+{
+    if (mem && (!scene || !scene->arena)) {
+        plyDealloc(mem);
+    }
+}
+
+/* copies size bytes into the scene's arena and frees the original, mem may be NULL */
+static void* moveIntoArena(struct PlyScene* scene, void* mem, const U64 size)
+{
+    if (!mem) {
+        return NULL;
+    }
+    void* copy = arenaAlloc(scene, size);
+    if (copy) {
+        memcpy(copy, mem, size);
+        plyDealloc(mem);
+    }
+    return copy;
+}
+
+/* size of the header of a parsed scene once moved into an arena */
+static U64 getSceneHeaderArenaSize(const struct PlyScene* scene)
+{
+    U64 size = alignArenaSize((U64)scene->elementCount * sizeof(struct PlyElement));
+    size += alignArenaSize((U64)scene->elementNames.capacity * sizeof(struct PlyNameSlot));
+    size += alignArenaSize((U64)scene->objectInfoCount * sizeof(struct PlyObjectInfo));
+    size += alignArenaSize((U64)scene->commentCount * sizeof(unsigned char*));
+    U32 i = 0u;
+    for (; i < scene->commentCount; ++i) {
+        size += alignArenaSize(strlen((const char*)scene->comments[i]) + 1u);
+    }
+    for (i = 0u; i < scene->elementCount; ++i) {
+        const struct PlyElement* element = scene->elements + i;
+        size += alignArenaSize((U64)element->propertyCount * sizeof(struct PlyProperty));
+        size += alignArenaSize((U64)element->propertyNames.capacity * sizeof(struct PlyNameSlot));
+    }
+    return size;
+}
+
+/* moves everything the header allocated into a new arena, with reserve more bytes in its first block for the data line tables.
+Nothing is moved if the block can not be allocated. */
+static enum PlyResult moveSceneIntoArena(struct PlyScene* scene, const U64 reserve)
+{
+    if (!addArenaBlock(scene, getSceneHeaderArenaSize(scene) + reserve)) {
+        return PLY_FAILED_ALLOC_ERROR;
+    }
+
+    /* the block has room for all of it, so none of these fail */
+    scene->elements = (struct PlyElement*)moveIntoArena(scene, scene->elements, (U64)scene->elementCount * sizeof(struct PlyElement));
+    scene->elementNames.slots = (struct PlyNameSlot*)moveIntoArena(scene, scene->elementNames.slots, (U64)scene->elementNames.capacity * sizeof(struct PlyNameSlot));
+    scene->objectInfos = (struct PlyObjectInfo*)moveIntoArena(scene, scene->objectInfos, (U64)scene->objectInfoCount * sizeof(struct PlyObjectInfo));
+    scene->comments = (unsigned char**)moveIntoArena(scene, scene->comments, (U64)scene->commentCount * sizeof(unsigned char*));
+    U32 i = 0u;
+    for (; i < scene->commentCount; ++i) {
+        scene->comments[i] = (unsigned char*)moveIntoArena(scene, scene->comments[i], strlen((const char*)scene->comments[i]) + 1u);
+    }
+    for (i = 0u; i < scene->elementCount; ++i) {
+        struct PlyElement* element = scene->elements + i;
+        element->inArena = true;
+        element->properties = (struct PlyProperty*)moveIntoArena(scene, element->properties, (U64)element->propertyCount * sizeof(struct PlyProperty));
+        element->propertyNames.slots = (struct PlyNameSlot*)moveIntoArena(scene, element->propertyNames.slots, (U64)element->propertyNames.capacity * sizeof(struct PlyNameSlot));
+    }
+    return PLY_SUCCESS;
+}
+
+
+
+/* true if the len characters at str are exactly the null terminated word */
+PLY_INLINE bool sliceEquals(const char* str, const U64 len, const char* word)
+{
+    return strlen(word) == len && memcmp(str, word, len) == 0;
+}
+
+/* returns the first whitespace at or after str, or end */
+PLY_INLINE const char* skipWord(const char* str, const char* end)
+{
+    while (str < end && isspace((unsigned char)*str) == 0) {
+        ++str;
+    }
+    return str;
+}
 
+/* returns the first non whitespace at or after str, or end */
+PLY_INLINE const char* skipSpaces(const char* str, const char* end)
+{
+    while (str < end && isspace((unsigned char)*str) != 0) {
+        ++str;
+    }
+    return str;
+}
 
 PLY_H_FUNCTION_PREFIX enum PlyScalarType PlyStrToScalarType(const char* str, const U64 strLen)
 {
-    if (strneql(str, "int8", min(strLen, strlen("int8"))) == true)
+    if (sliceEquals(str, strLen, "int8"))
     {
         return PLY_SCALAR_TYPE_CHAR;
     }
-    if (strneql(str, "uint8", min(strLen, strlen("uint8"))) == true)
+    if (sliceEquals(str, strLen, "uint8"))
     {
         return PLY_SCALAR_TYPE_UCHAR;
     }
-    if (strneql(str, "int16", min(strLen, strlen("int16"))) == true)
+    if (sliceEquals(str, strLen, "int16"))
     {
         return PLY_SCALAR_TYPE_SHORT;
     }
-    if (strneql(str, "uint16", min(strLen, strlen("uint16"))) == true)
+    if (sliceEquals(str, strLen, "uint16"))
     {
         return PLY_SCALAR_TYPE_USHORT;
     }
-    if (strneql(str, "int32", min(strLen, strlen("int32"))) == true)
+    if (sliceEquals(str, strLen, "int32"))
     {
         return PLY_SCALAR_TYPE_INT;
     }
-    if (strneql(str, "uint32", min(strLen, strlen("uint32"))) == true)
+    if (sliceEquals(str, strLen, "uint32"))
     {
         return PLY_SCALAR_TYPE_UINT;
     }
+    if (sliceEquals(str, strLen, "float32"))
+    {
+        return PLY_SCALAR_TYPE_FLOAT;
+    }
+    if (sliceEquals(str, strLen, "float64"))
+    {
+        return PLY_SCALAR_TYPE_DOUBLE;
+    }
     
 
     /* - - - - - - - - - - - - - - - - - - */
 
-    if (strneql(str, "char", min(strLen, strlen("char"))) == true)
+    if (sliceEquals(str, strLen, "char"))
     {
         return PLY_SCALAR_TYPE_CHAR;
     }
-    if (strneql(str, "uchar", min(strLen, strlen("uchar"))) == true)
+    if (sliceEquals(str, strLen, "uchar"))
     {
         return PLY_SCALAR_TYPE_UCHAR;
     }
-    if (strneql(str, "short", min(strLen, strlen("short"))) == true)
+    if (sliceEquals(str, strLen, "short"))
     {
         return PLY_SCALAR_TYPE_SHORT;
     }
-    if (strneql(str, "ushort", min(strLen, strlen("ushort"))) == true)
+    if (sliceEquals(str, strLen, "ushort"))
     {
         return PLY_SCALAR_TYPE_USHORT;
     }
-    if (strneql(str, "int", min(strLen, strlen("int"))) == true)
+    if (sliceEquals(str, strLen, "int"))
     {
         return PLY_SCALAR_TYPE_INT;
     }
-    if (strneql(str, "uint", min(strLen, strlen("uint"))) == true)
+    if (sliceEquals(str, strLen, "uint"))
     {
         return PLY_SCALAR_TYPE_UINT;
     }
-    if (strneql(str, "float", min(strLen, strlen("float"))) == true)
+    if (sliceEquals(str, strLen, "float"))
     {
         return PLY_SCALAR_TYPE_FLOAT;
     }
-    if (strneql(str, "double", min(strLen, strlen("double"))) == true)
+    if (sliceEquals(str, strLen, "double"))
     {
         return PLY_SCALAR_TYPE_DOUBLE;
     }
@@ -297,19 +667,38 @@ PLY_H_FUNCTION_PREFIX I64 PlyGetPropertyIndex(const struct PlyElement* element,
 * If the element is not in that property, -1 will be returned. */
 PLY_H_FUNCTION_PREFIX I64 PlyGetPropertyIndexByName(const struct PlyElement* element, const char* propertyName)
 {
-    U32 i = 0;
-    for (; i < element->propertyCount; ++i)
-    {
-        if (streql(element->properties[i].name, propertyName)) {
-            return i;
-        }
-    }
-    return -1;
+    return findPropertyName(element, propertyName, hashName(propertyName));
+}
+
+PLY_H_FUNCTION_PREFIX I64 PlyGetPropertyIndexByHandle(const struct PlyElement* element, const struct PlyNameHandle* propertyName)
+{
+    return findPropertyName(element, propertyName->name, propertyName->hash);
+}
+
+PLY_H_FUNCTION_PREFIX I64 PlyGetElementIndexByName(const struct PlyScene* scene, const char* elementName)
+{
+    return findElementName(scene, elementName, hashName(elementName));
+}
+
+PLY_H_FUNCTION_PREFIX I64 PlyGetElementIndexByHandle(const struct PlyScene* scene, const struct PlyNameHandle* elementName)
+{
+    return findElementName(scene, elementName->name, elementName->hash);
+}
+
+PLY_H_FUNCTION_PREFIX struct PlyNameHandle PlyInternName(const char* name)
+{
+    struct PlyNameHandle handle;
+    handle.name = name;
+    handle.hash = hashName(name);
+    return handle;
 }
 
 /* adds a PlyProperty to an element.The property will be copied, thus transferring ownership */
 PLY_INLINE enum PlyResult  PlyElementAddProperty(struct PlyElement* element, struct PlyProperty* property)
 {
+    if (element->inArena) {
+        return PLY_GENERIC_ERROR; /* the arena can not grow its arrays */
+    }
     if (element->propertyCount == UINT32_MAX - 1) {
         return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
     }
@@ -321,6 +710,7 @@ PLY_INLINE enum PlyResult  PlyElementAddProperty(struct PlyElement* element, str
     else {
         element->properties = tmp;
         element->properties[element->propertyCount] = *property;
+        addToNameTable(&element->propertyNames, hashName(property->name), element->propertyCount);
         element->propertyCount = newPropertyCount;
     }
     return PLY_SUCCESS;
@@ -331,6 +721,9 @@ PLY_INLINE enum PlyResult PlySceneAddObjectInfo(struct PlyScene* scene, struct P
 {
 #define OBJ_INFOS scene->objectInfos
 #define OBJ_INFO_COUNT scene->objectInfoCount
+    if (scene->arena) {
+        return PLY_GENERIC_ERROR; /* the arena can not grow its arrays */
+    }
     if (OBJ_INFO_COUNT == UINT32_MAX - 1) {
         return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
     }
@@ -358,6 +751,9 @@ PLY_INLINE enum PlyResult PlySceneAddObjectInfo(struct PlyScene* scene, struct P
 /* adds a PlyElement to a scene.The element will be copied, thus transferring ownership */
 PLY_INLINE enum PlyResult PlySceneAddElement(struct PlyScene* scene, struct PlyElement* element)
 {
+    if (scene->arena || element->inArena) {
+        return PLY_GENERIC_ERROR; /* the arena can not grow its arrays */
+    }
     if (scene->elementCount == UINT32_MAX - 1)  {
         return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
     }
@@ -369,6 +765,8 @@ PLY_INLINE enum PlyResult PlySceneAddElement(struct PlyScene* scene, struct PlyE
     else {
         scene->elements = tmp;
         scene->elements[scene->elementCount] = *element;
+        refreshElementNames(scene);
+        addToNameTable(&scene->elementNames, hashName(element->name), scene->elementCount);
         scene->elementCount = newElementCount;
     }
     return PLY_SUCCESS;
@@ -382,289 +780,82 @@ PLY_H_FUNCTION_PREFIX enum PlyResult PlyElementSetName(struct PlyElement* elemen
     }
     memcpy(element->name, name, len+1);
     element->name[len]='\0';
+    ++plyElementRenameCount;
     return PLY_SUCCESS;
 }
 
-PLY_INLINE U32 lineLen_s(const char* srcline, const char* mem, U64 memSize)
+/* parses the rest of a property line, [propBegin, lineEnd) holds the types and the name */
+PLY_INLINE enum PlyResult parseProperty(struct PlyElement* owningElement, const char* propBegin, const char* lineEnd)
 {
-    if (!srcline || srcline < mem || srcline > mem + memSize - 1)
-        return 0x0;
-
-    U64 maxDist = (U64)((mem + (U64)memSize) - srcline);
-    if (maxDist > UINT32_MAX)
-        return 0x0;
+    /* data type */
+    enum PlyDataType dtype = PLY_DATA_TYPE_SCALAR;
+    /* list count type */
+    enum PlyScalarType ltype = PLY_SCALAR_TYPE_UNDEFINED;
 
-    const char* end = mem + memSize;
-    const char* cur = srcline;
-    while (cur < end)
-    {
-        char c = *cur;
-        if (c == '\0' || c == '\n' || c == '\r')
-            return (U32)(cur - srcline);
-        ++cur;
-    }
+    /* the first word is "list" or the scalar type */
+    const char* next = skipSpaces(propBegin, lineEnd);
+    const char* wordEnd = skipWord(next, lineEnd);
+    if (sliceEquals(next, wordEnd - next, "list")) {
+        dtype = PLY_DATA_TYPE_LIST;
 
-    /* invalid line, no null terminator */
-    return 0u;
-}
+        /* get list count type */
+        next = skipSpaces(wordEnd, lineEnd);
+        wordEnd = skipWord(next, lineEnd);
+        ltype = PlyStrToScalarType(next, wordEnd - next);
+        if (ltype == PLY_SCALAR_TYPE_UNDEFINED) {
+            return PLY_MALFORMED_FILE_ERROR;
+        }
 
+        next = skipSpaces(wordEnd, lineEnd);
+        wordEnd = skipWord(next, lineEnd);
+    }
 
-PLY_INLINE void parseLine(const char* lineIn, U64 lineInSize, char* dst, const U32 dstSize, U32* strlenOut)
-{
-    *strlenOut = 0;
+    /* get scalar type */
+    const enum PlyScalarType stype = PlyStrToScalarType(next, wordEnd - next);
+    if (stype == PLY_SCALAR_TYPE_UNDEFINED) {
+        return PLY_MALFORMED_FILE_ERROR;
+    }
 
-    if (!lineIn || !dst || dstSize == 0 || lineInSize == 0)
-        return;
+    /*get name, the rest of the line*/
+    next = skipSpaces(wordEnd, lineEnd);
+    if (next == lineEnd)
+        return PLY_MALFORMED_FILE_ERROR;
 
-    /* Skip leading whitespace*/
-    U64 start = 0;
-    while (start < lineInSize && isblank((unsigned char)lineIn[start]))
-        ++start;
+    const char* nameFirst = next;
+    const U64 nameLen = lineEnd - next;
+    if (nameLen > PLY_MAX_ELEMENT_AND_PROPERTY_NAME_LENGTH) {
+        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+    }
 
-    if (start == lineInSize)
-        return;
+ 
 
-    /* Remove trailing whitespace */
-    U64 end = lineInSize;
-    while (end > start && isblank((unsigned char)lineIn[end - 1]))
-        --end;
+    struct PlyProperty property = {0};
+    property.dataType = dtype;
+    property.listCountType = ltype;
+    property.scalarType = stype;
 
-    U64 cleanLen = end - start;
-    if (cleanLen >= dstSize)
-        cleanLen = dstSize - 1;
+    memcpy_s(property.name, sizeof(property.name), nameFirst, nameLen);
+    property.name[nameLen] = '\0';
+    
+    if (checkForPropertyNameCollision(owningElement, property.name) == true)
+        return PLY_MALFORMED_HEADER_ERROR;
 
-    memcpy(dst, lineIn + start, cleanLen);
-    dst[cleanLen] = '\0';
-    *strlenOut = (U32)cleanLen;
+    const enum PlyResult r = PlyElementAddProperty(owningElement, &property);
+    
+    return r;
 }
 
-PLY_INLINE const char* getNextLine(U64* lenOut, const U8* mem, U64 memSize, const char* lastLine, const U64 lastLineLen)
-{
-    if (lastLineLen > UINT32_MAX || memSize > UINT32_MAX) {
-        return NULL;
-    }
-
-    const char* lastLineLast = lastLine + lastLineLen;
-    if (!lastLine || !mem || !memSize || (const U8*)lastLine < mem || (const U8*)lastLineLast >= (mem + (memSize - 1))) {
-        return NULL;
-    }
 
-    /* the first char in the line */
-    const char* lineBegin = NULL;
-    /* 1-past the last char in the line. */
-    const char* lineLast = NULL;
-
-    /* find lineBegin */
-    U64 dist = (mem + memSize - (const U8*)lastLine);
-    if (dist == 0) {
-        return NULL;
-    }
-    const U64 loopLimit1 = dist - 1;
-    U64 i = 0;
-    for (; i < loopLimit1; ++i)
-    {
-        const char* cur = lastLine + i;
-        if (cur == (const char*)UINT64_MAX) { return NULL; }
+PLY_INLINE enum PlyResult parseObjectInfo(struct PlyScene* scene, const char* objBegin, const char* objEnd)
+{
+    /*get name begin*/
+    const char* NameBegin = NULL;
 
-        if (*cur == '\n')
+    const char* ch = objBegin;
+    for (; ch <= objEnd; ++ch) {
+        if (isspace(*ch) == 0) 
         {
-            lineBegin = cur + 1;
-            break;
-        }
-        if (*cur == '\0')
-        {
-            return NULL;
-        }
-    }
-
-    if (!lineBegin)
-        return NULL;
-
-
-
-    /* find line end */
-    dist = (mem + memSize - (const U8*)lineBegin);
-    
-    i = 0;
-    for (; i < dist; ++i)
-    {
-        const char* cur = lineBegin + i;
-        if (cur == (const char*)UINT64_MAX) { return NULL; }
-        if (*cur == '\n' || *cur == '\r' || cur == (const char*)(mem + memSize - 1))
-        {
-            if (i == dist) {
-                lineLast = NULL;
-                break;
-            }
-
-            if (cur == (const char*)(mem + memSize - 1)) {
-                lineLast = cur;
-            } else {
-                lineLast = cur - 1;
-            }
-            break;
-        }
-        if (*cur == '\0')
-        {
-            lineLast = cur - 1;
-            break;
-        }
-    }
-
-    if (!lineLast) {
-        return NULL;
-    }
-
-    if (lineLast < lineBegin) {
-        return lineBegin; /*for lines that only have newlines preceding them (i.e. begin ... /n/n/n/n ... more lines)*/
-    }
-    if (lineLast == (const char*)UINT64_MAX - 1) {
-        return NULL;
-    }
-
-
-
-    *lenOut = lineLast - lineBegin + 1;
-
-    return lineBegin;
-}
-
-PLY_INLINE const char* getNextSpace(const char* srchBegin, const char* srchEnd)
-{
-    const char* ch = srchBegin;
-    for (; ch <= srchEnd; ++ch)
-    {
-        if (isspace(*ch) != 0) {
-            return ch;
-        }
-    }
-    return NULL;
-}
-
-
-PLY_INLINE const char* getNextNonSpace(const char* srchBegin, const char* srchEnd)
-{
-    const char* ch = srchBegin;
-    for (; ch <= srchEnd; ++ch)
-    {
-        if (isspace(*ch) == 0) {
-            return ch;
-        }
-    }
-    return NULL;
-}
-
-PLY_INLINE enum PlyResult parseProperty(struct PlyElement* owningElement, const char* propRangeFirst, const char* propRangeLast)
-{
-    /* data type */
-    enum PlyDataType dtype = PLY_DATA_TYPE_SCALAR;
-    /* scalar type */
-    enum PlyScalarType stype = PLY_SCALAR_TYPE_UNDEFINED;
-    /* list count type */
-    enum PlyScalarType ltype = PLY_SCALAR_TYPE_UNDEFINED;
-
-    const char* next = NULL;
-    next = getNextNonSpace(propRangeFirst, propRangeLast);
-    if (!next)
-    {
-        return PLY_MALFORMED_FILE_ERROR;
-    }
-
-
-
-    /* get data type(list / scalar) */
-    U64 dist = 0u;
-    dist = (propRangeLast - next) + 1;
-    if (strneql(next, "list", min(dist, strlen("list")))==true) {
-        dtype = PLY_DATA_TYPE_LIST;
-    }
-
-    /* get scalar type */
-    next = getNextNonSpace(next, propRangeLast);
-    if (!next) {
-        return PLY_MALFORMED_FILE_ERROR;
-    }
-
-    dist = (propRangeLast - next) + 1;
-    if (dtype == PLY_DATA_TYPE_SCALAR) {
-        /* get scalar type */
-        stype = PlyStrToScalarType(next, dist);
-    }
-    else if (dtype == PLY_DATA_TYPE_LIST) {
-
-        /* get list type */
-        next = getNextSpace(next, propRangeLast);
-        if (!next)
-            return PLY_MALFORMED_FILE_ERROR;
-        next = getNextNonSpace(next, propRangeLast);
-        if (!next) {
-            return PLY_MALFORMED_FILE_ERROR;
-        }
-
-        ltype = PlyStrToScalarType(next, dist);
-
-
-        /* get scalar type */
-        next = getNextSpace(next, propRangeLast);
-        if (!next)
-            return PLY_MALFORMED_FILE_ERROR;
-        next = getNextNonSpace(next, propRangeLast);
-        if (!next) {
-            return PLY_MALFORMED_FILE_ERROR;
-        }
-
-        dist = (propRangeLast - next) + 1;
-        stype = PlyStrToScalarType(next, dist);
-    }
-
-    if (stype == PLY_SCALAR_TYPE_UNDEFINED) {
-        return PLY_MALFORMED_FILE_ERROR;
-    }
-
-
-    /*get name*/
-    next = getNextSpace(next, propRangeLast);
-    if (!next)
-        return PLY_MALFORMED_FILE_ERROR;
-    next = getNextNonSpace(next, propRangeLast);
-    if (!next)
-        return PLY_MALFORMED_FILE_ERROR;
-
-    const char* nameFirst = next;
-    const U64 nameLen = (propRangeLast - next)+1;
-    if (nameLen > PLY_MAX_ELEMENT_AND_PROPERTY_NAME_LENGTH) {
-        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-    }
-
- 
-
-    struct PlyProperty property = {0};
-    property.dataType = dtype;
-    property.listCountType = ltype;
-    property.scalarType = stype;
-
-    memcpy_s(property.name, sizeof(property.name), nameFirst, nameLen);
-    property.name[nameLen] = '\0';
-    
-    if (checkForPropertyNameCollision(owningElement, property.name) == true)
-        return PLY_MALFORMED_HEADER_ERROR;
-
-    const enum PlyResult r = PlyElementAddProperty(owningElement, &property);
-    
-    return r;
-}
-
-
-PLY_INLINE enum PlyResult parseObjectInfo(struct PlyScene* scene, const char* objBegin, const char* objEnd)
-{
-    /*get name begin*/
-    const char* NameBegin = NULL;
-
-    const char* ch = objBegin;
-    for (; ch <= objEnd; ++ch) {
-        if (isspace(*ch) == 0) 
-        {
-            NameBegin = ch;
+            NameBegin = ch;
             break;
         }
     }
@@ -697,23 +888,15 @@ PLY_INLINE enum PlyResult parseObjectInfo(struct PlyScene* scene, const char* ob
     if (!ValBegin)
         return PLY_MALFORMED_HEADER_ERROR;
 
-    /*get val end*/
-    const char* ValEnd = NULL;
+    /*get val end, objEnd if the value runs to the end of the line*/
+    const char* ValEnd = objEnd;
     ch = ValBegin;
     for (; ch <= objEnd; ++ch) {
-        if (ch == objEnd) /*if ValBegin is at the end of the obj data src*/
-        {
-            ValEnd = ValBegin;
-            break;
-        }
         if (isspace(*ch) != 0) {
-
             ValEnd = ch-1;
             break;
         }
     }
-    if (!ValEnd)
-        return PLY_MALFORMED_HEADER_ERROR;
 
 
     struct PlyObjectInfo objInfo = { 0 };
@@ -723,8 +906,21 @@ PLY_INLINE enum PlyResult parseObjectInfo(struct PlyScene* scene, const char* ob
 
 
 
+    /* the value is parsed from a copy because the line is not null terminated, long values are copied to the heap */
+    char stackStr[64];
+    const U64 valLen = ValEnd - ValBegin + 1;
+    char* valStr = valLen < sizeof(stackStr) ? stackStr : (char*)plyRealloc(NULL, valLen + 1);
+    if (!valStr) {
+        return PLY_FAILED_ALLOC_ERROR;
+    }
+    memcpy(valStr, ValBegin, valLen);
+    valStr[valLen] = '\0';
+
     U8 strlen=0u;
-    double val = strtod64(ValBegin, &strlen);
+    double val = strtod64(valStr, &strlen);
+    if (valStr != stackStr) {
+        plyDealloc(valStr);
+    }
     if (strlen == 0) {
         return PLY_MALFORMED_HEADER_ERROR;
     }
@@ -735,947 +931,3239 @@ PLY_INLINE enum PlyResult parseObjectInfo(struct PlyScene* scene, const char* ob
     return r;
 }
 
-PLY_INLINE enum PlyResult readHeaderLine(const char* line, const U32 lineLen, bool* readingHeader, struct PlyElement** curElement, struct PlyScene* scene, struct PlyLoadInfo* loadInfo)
+enum PlyHeaderKeyword
 {
-    if (lineLen == 0)
-        return PLY_SUCCESS;
+    PLY_HEADER_KEYWORD_UNKNOWN = 0,
+    PLY_HEADER_KEYWORD_PLY,
+    PLY_HEADER_KEYWORD_FORMAT,
+    PLY_HEADER_KEYWORD_COMMENT,
+    PLY_HEADER_KEYWORD_OBJ_INFO,
+    PLY_HEADER_KEYWORD_ELEMENT,
+    PLY_HEADER_KEYWORD_PROPERTY,
+    PLY_HEADER_KEYWORD_END_HEADER
+};
+
+/* identifies the first word of a header line by its first character and length, so most lines cost a single compare */
+PLY_INLINE enum PlyHeaderKeyword getHeaderKeyword(const char* word, const U64 len)
+{
+    switch (word[0])
+    {
+    case 'p':
+        if (len == 8u && sliceEquals(word, len, "property")) return PLY_HEADER_KEYWORD_PROPERTY;
+        if (len == 3u && sliceEquals(word, len, "ply")) return PLY_HEADER_KEYWORD_PLY;
+        break;
+    case 'c':
+        if (len == 7u && sliceEquals(word, len, "comment")) return PLY_HEADER_KEYWORD_COMMENT;
+        break;
+    case 'e':
+        if (len == 7u && sliceEquals(word, len, "element")) return PLY_HEADER_KEYWORD_ELEMENT;
+        if (len == 10u && sliceEquals(word, len, "end_header")) return PLY_HEADER_KEYWORD_END_HEADER;
+        break;
+    case 'f':
+        if (len == 6u && sliceEquals(word, len, "format")) return PLY_HEADER_KEYWORD_FORMAT;
+        break;
+    case 'o':
+        if (len == 8u && sliceEquals(word, len, "obj_info")) return PLY_HEADER_KEYWORD_OBJ_INFO;
+        break;
+    default:
+        break;
+    }
+    return PLY_HEADER_KEYWORD_UNKNOWN;
+}
+
+PLY_INLINE enum PlyResult parseComment(struct PlyScene* scene, const char* commentBegin, const char* lineEnd)
+{
+    commentBegin = skipSpaces(commentBegin, lineEnd);
+    const U64 commentLen = lineEnd - commentBegin;
+
+    U32 newCommentCount = scene->commentCount + 1;
+    if (newCommentCount < scene->commentCount) /*prevent overflow*/
+        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+    unsigned char** comments = plyReCalloc(scene->comments, scene->commentCount, newCommentCount, sizeof(char*));
+    if (!comments)
+        return PLY_FAILED_ALLOC_ERROR;
+    scene->comments = comments;
 
-    /* the last character in the line.*/
-    const char* lineLast = line + lineLen - 1;
+    unsigned char* tmp = (unsigned char*)plyRealloc(NULL, commentLen + 1);
+    if (!tmp)
+        return PLY_FAILED_ALLOC_ERROR;
+
+    memcpy(tmp, commentBegin, commentLen);
+    tmp[commentLen] = '\0';
+    scene->comments[scene->commentCount] = tmp;
+    scene->commentCount = newCommentCount;
+    return PLY_SUCCESS;
+}
 
-    if (lineLast == NULL || !readingHeader) {
+PLY_INLINE enum PlyResult parseFormat(struct PlyScene* scene, const char* formatBegin, const char* lineEnd, const struct PlyLoadInfo* loadInfo)
+{
+    const char* format = skipSpaces(formatBegin, lineEnd);
+    const char* formatEnd = skipWord(format, lineEnd);
+    const U64 formatLen = formatEnd - format;
+    if (sliceEquals(format, formatLen, "ascii")) {
+        scene->format = PLY_FORMAT_ASCII;
+    }
+    else if (sliceEquals(format, formatLen, "binary_little_endian")) {
+        scene->format = PLY_FORMAT_BINARY_LITTLE_ENDIAN;
+    }
+    else if (sliceEquals(format, formatLen, "binary_big_endian")) {
+        scene->format = PLY_FORMAT_BINARY_BIG_ENDIAN;
+    }
+    else {
         return PLY_MALFORMED_HEADER_ERROR;
     }
 
-    const char* c = "ply";
-    if (strneql(line, c, min(strlen(c), lineLen)) == true)
-    {
-        *curElement = NULL;
-        *readingHeader = true;
-        return PLY_SUCCESS;
+    /*get version number(currently only v 1.0 is considered valid, unless allowAnyVersion is true)*/
+    const char* version = skipSpaces(formatEnd, lineEnd);
+    const U64 versionLen = skipWord(version, lineEnd) - version;
+    char versionStr[32];
+    if (versionLen == 0u || versionLen >= sizeof(versionStr)) {
+        return PLY_MALFORMED_HEADER_ERROR;
     }
-    
-    c = "end_header";
-    if (strneql(line, c, min(strlen(c), lineLen)) == true)
+    memcpy(versionStr, version, versionLen);
+    versionStr[versionLen] = '\0';
+
+    scene->versionNumber = strtof(versionStr, NULL);
+    if ((!loadInfo || loadInfo->allowAnyVersion == false) && scene->versionNumber != 1.0)
     {
-        *curElement = NULL;
-        *readingHeader = false;
-        return PLY_SUCCESS;
+        scene->versionNumber = 0.0;
+        return PLY_UNSUPPORTED_VERSION_ERROR;
     }
+    return PLY_SUCCESS;
+}
 
+/* adds the element to the scene even if PlyLoadInfo::elements excludes it, its layout is needed to skip its data */
+PLY_INLINE enum PlyResult parseElement(struct PlyScene* scene, struct PlyElement** curElement, const char* elementBegin, const char* lineEnd)
+{
+    const char* name = skipSpaces(elementBegin, lineEnd);
+    const char* nameEnd = skipWord(name, lineEnd);
+    const U64 nameLen = nameEnd - name;
+    if (nameLen == 0u) {
+        return PLY_MALFORMED_HEADER_ERROR;
+    }
+    if (nameLen > PLY_MAX_ELEMENT_AND_PROPERTY_NAME_LENGTH) {
+        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+    }
 
+    const char* count = skipSpaces(nameEnd, lineEnd);
+    const char* countEnd = skipWord(count, lineEnd);
+    if (count == countEnd) {
+        return PLY_MALFORMED_HEADER_ERROR;
+    }
+    U64 dataCount = 0u;
+    for (; count < countEnd; ++count) {
+        if (*count < '0' || *count > '9') {
+            return PLY_MALFORMED_HEADER_ERROR;
+        }
+        dataCount = dataCount * 10u + (U64)(*count - '0');
+        if (dataCount > UINT32_MAX) {
+            return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+        }
+    }
 
+    struct PlyElement element = { 0 };
+    memcpy(element.name, name, nameLen);
+    element.name[nameLen] = '\0';
+    element.dataLineCount = (U32)dataCount;
 
-    if (*readingHeader) { 
-        if (loadInfo && loadInfo->saveComments) 
-        {
-            c = "comment";
-            if (strneql(line, c, min(strlen(c), lineLen)) == true)
-            {
-                const char* commentBegin = line + strlen(c);
+    if (checkForElementNameCollision(scene, element.name) == true)
+        return PLY_MALFORMED_HEADER_ERROR;
 
-                for (;
-                    commentBegin < line + lineLen && isspace(*commentBegin);
-                    ++commentBegin) {
-                }
+    if (PlySceneAddElement(scene, &element)!=PLY_SUCCESS)
+    {
+        return PLY_FAILED_ALLOC_ERROR;
+    }
 
+    *curElement = &scene->elements[scene->elementCount-1];
+    return PLY_SUCCESS;
+}
 
+/* parses one header line. line points into the file and has no line break or surrounding whitespace. */
+PLY_INLINE enum PlyResult readHeaderLine(const char* line, const U64 lineLen, bool* readingHeader, bool* headerFinished, struct PlyElement** curElement, struct PlyScene* scene, const struct PlyLoadInfo* loadInfo)
+{
+    const char* lineEnd = line + lineLen;
+    const char* wordEnd = skipWord(line, lineEnd);
 
+    switch (getHeaderKeyword(line, wordEnd - line))
+    {
+    case PLY_HEADER_KEYWORD_PLY:
+        *curElement = NULL;
+        *readingHeader = true;
+        return PLY_SUCCESS;
+    case PLY_HEADER_KEYWORD_END_HEADER:
+        *curElement = NULL;
+        *headerFinished = *readingHeader;
+        return PLY_SUCCESS;
+    case PLY_HEADER_KEYWORD_COMMENT:
+        if (*readingHeader && loadInfo && loadInfo->saveComments)
+            return parseComment(scene, wordEnd, lineEnd);
+        return PLY_SUCCESS;
+    case PLY_HEADER_KEYWORD_FORMAT:
+        if (!*readingHeader)
+            return PLY_SUCCESS;
+        *curElement = NULL;
+        return parseFormat(scene, wordEnd, lineEnd, loadInfo);
+    case PLY_HEADER_KEYWORD_ELEMENT:
+        if (!*readingHeader)
+            return PLY_SUCCESS;
+        *curElement = NULL;
+        return parseElement(scene, curElement, wordEnd, lineEnd);
+    case PLY_HEADER_KEYWORD_PROPERTY:
+        if (!*readingHeader || *curElement == NULL)
+            return PLY_SUCCESS;
+        return parseProperty(*curElement, wordEnd, lineEnd);
+    case PLY_HEADER_KEYWORD_OBJ_INFO:
+        if (!*readingHeader)
+            return PLY_SUCCESS;
+        return parseObjectInfo(scene, wordEnd, lineEnd - 1);
+    default:
+        /* there is nothing to read, skip this line. */
+        return PLY_SUCCESS;
+    }
+}
 
-                const U64 commentLen = (line + lineLen) - commentBegin;
 
+/* computes dataLineStride of the element and the dataLineOffset of each of its properties */
+PLY_INLINE enum PlyResult setElementLayout(struct PlyElement* element)
+{
+    U64 stride = 0u;
+    U32 pi = 0u;
+    for (; pi < element->propertyCount; ++pi) {
+        struct PlyProperty* property = element->properties + pi;
+        if (property->dataType != PLY_DATA_TYPE_SCALAR) {
+            element->dataLineStride = 0u;
+            return PLY_SUCCESS;
+        }
+        property->dataLineOffset = (U32)stride;
+        stride += PlyGetSizeofScalarType(property->scalarType);
+        if (stride > UINT32_MAX) {
+            return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+        }
+    }
+    element->dataLineStride = (U32)stride;
+    return PLY_SUCCESS;
+}
 
-                U32 newCommentCount = scene->commentCount + 1;
-                if (newCommentCount < scene->commentCount) /*prevent overflow*/
-                    return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-                scene->comments = plyReCalloc(scene->comments, scene->commentCount, newCommentCount, sizeof(char*));
+/* runs worker(ctx, i) for every i in [0, workerCount), worker 0 runs on the calling thread.
+If a thread cannot be created its work is done on the calling thread instead. */
+typedef void (*PlyParallelWorker)(void* ctx, U32 workerIdx);
 
-                unsigned char* tmp = (unsigned char*)plyRealloc(NULL, commentLen + 1);
-                if (!tmp)
-                    return PLY_FAILED_ALLOC_ERROR;
+#if !defined(PLY_NO_THREADS)
+struct PlyThreadArgs
+{
+    PlyParallelWorker worker;
+    void* ctx;
+    U32 workerIdx;
+};
 
+#if defined(_WIN32)
+static DWORD WINAPI plyThreadEntry(LPVOID arg)
+{
+    struct PlyThreadArgs* args = (struct PlyThreadArgs*)arg;
+    args->worker(args->ctx, args->workerIdx);
+    return 0;
+}
+#else
+static void* plyThreadEntry(void* arg)
+{
+    struct PlyThreadArgs* args = (struct PlyThreadArgs*)arg;
+    args->worker(args->ctx, args->workerIdx);
+    return NULL;
+}
+#endif
+#endif /* !PLY_NO_THREADS */
 
+#define PLY_MAX_THREADS 64u
 
-                scene->comments[scene->commentCount] = tmp;
+static void runParallel(PlyParallelWorker worker, void* ctx, U32 workerCount)
+{
+    U32 i = 0u;
+#if !defined(PLY_NO_THREADS)
+    if (workerCount > PLY_MAX_THREADS) {
+        workerCount = PLY_MAX_THREADS;
+    }
+    struct PlyThreadArgs args[PLY_MAX_THREADS];
+    bool started[PLY_MAX_THREADS];
+#if defined(_WIN32)
+    HANDLE threads[PLY_MAX_THREADS];
+#else
+    pthread_t threads[PLY_MAX_THREADS];
+#endif
 
-                memcpy(scene->comments[scene->commentCount], commentBegin, commentLen);
+    for (i = 1u; i < workerCount; ++i) {
+        args[i].worker = worker;
+        args[i].ctx = ctx;
+        args[i].workerIdx = i;
+#if defined(_WIN32)
+        threads[i] = CreateThread(NULL, 0, plyThreadEntry, args + i, 0, NULL);
+        started[i] = threads[i] != NULL;
+#else
+        started[i] = pthread_create(threads + i, NULL, plyThreadEntry, args + i) == 0;
+#endif
+    }
 
-                scene->comments[scene->commentCount][commentLen] = '\0';
+    worker(ctx, 0u);
 
-                scene->commentCount = newCommentCount;
+    for (i = 1u; i < workerCount; ++i) {
+        if (!started[i]) {
+            worker(ctx, i);
+            continue;
+        }
+#if defined(_WIN32)
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+#else
+    for (; i < workerCount; ++i) {
+        worker(ctx, i);
+    }
+#endif /* !PLY_NO_THREADS */
+}
 
-                return PLY_SUCCESS;
-            }
+/* returns the size shared by every value of an element with a dataLineStride, or 0 if the sizes differ */
+PLY_INLINE U8 getUniformScalarSize(const struct PlyElement* element)
+{
+    if (element->propertyCount == 0u) {
+        return 0u;
+    }
+    const U8 size = PlyGetSizeofScalarType(element->properties[0].scalarType);
+    U32 pi = 0u;
+    for (; pi < element->propertyCount; ++pi) {
+        const struct PlyProperty* property = element->properties + pi;
+        if (PlyGetSizeofScalarType(property->scalarType) != size) {
+            return 0u;
+        }
+        if (property->dataType == PLY_DATA_TYPE_LIST && !property->denseList && PlyGetSizeofScalarType(property->listCountType) != size) {
+            return 0u;
         }
+    }
+    return size;
+}
 
-        /*look for format keyword*/
-        c = "format ";
-        if (strneql(line, c, min(strlen(c), lineLen)) == true)
-        {
-            *curElement = NULL;
-
-            /*just beyond the end of format(last char + 1)*/
-            const char* formatEnd = NULL;
-            /*look for ascii keyword*/
-            U64 i = strlen("format");
-            for (; i < lineLen; ++i) {
-                if (strneql(line + i, "ascii", min(strlen("ascii"), lineLen - i)) == true)
-                {
-                    scene->format = PLY_FORMAT_ASCII;
-                    formatEnd = line + i + strlen("ascii");
-                    goto getVersion;
-                }
-            }
+/* size of the element's data in a binary file, which is larger than dataSize if its list counts were dropped */
+PLY_INLINE U64 getBinaryElementFileSize(const struct PlyElement* element)
+{
+    if (element->dataLineStride != 0u && element->propertyCount == 1u && element->properties[0].denseList) {
+        const U64 listCountSize = PlyGetSizeofScalarType(element->properties[0].listCountType);
+        return ((U64)element->dataLineStride + listCountSize) * element->dataLineCount;
+    }
+    return element->dataSize;
+}
 
+/* if compact is true, only list elements will get dataLineBegins and no element will get dataLineOffsets.
+scene is the owner of the element, or NULL if it does not have one yet */
+PLY_INLINE enum PlyResult allocateDataLinesForElement(struct PlyScene* scene, struct PlyElement* element, const bool compact)
+{
+    if (compact && element->dataLineStride != 0u) {
+        return PLY_SUCCESS;
+    }
 
-            /*look for binary_big_endian  keyword*/
-            i = strlen("format");
-            for (; i < lineLen; ++i) {
-                if (strneql(line + i, "binary_big_endian", min(strlen("binary_big_endian"), lineLen - i)) == true)
-                {
-                    scene->format = PLY_FORMAT_BINARY_BIG_ENDIAN;
-                    formatEnd = line + i + strlen("binary_big_endian");
-                    goto getVersion;
-                }
+    sceneDealloc(scene, element->dataLineBegins);
+    element->dataLineBegins = (U64*)sceneCalloc(scene, element->dataLineCount, sizeof(U64));
+    if (!element->dataLineBegins) {
+        return PLY_FAILED_ALLOC_ERROR;
+    }
+
+    if (compact) {
+        return PLY_SUCCESS;
+    }
+
+    /* create data line offsets for the properties of this element*/
+    U64 pi = 0u;
+    for (; pi < element->propertyCount; ++pi) {
+        struct PlyProperty* property = element->properties + pi;
+        property->dataLineOffsets = (U32*)sceneCalloc(scene, element->dataLineCount, sizeof(U32));
+        if (!property->dataLineOffsets) {
+            return PLY_FAILED_ALLOC_ERROR;
+        }
+    }
+    return PLY_SUCCESS;
+}
+
+/* swaps the bytes of count contiguous values of scalarSize bytes */
+static void swapBytesRun(U8* mem, const U64 count, const U8 scalarSize)
+{
+    U64 i = 0u;
+    const U64 size = count * scalarSize;
+
+#if PLY_USE_SSSE3
+    if (scalarSize == 2 || scalarSize == 4 || scalarSize == 8)
+    {
+        /* shuffle masks that reverse every scalarSize byte group of a 16 byte lane */
+        __m128i mask;
+        if (scalarSize == 2) {
+            mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+        }
+        else if (scalarSize == 4) {
+            mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        }
+        else {
+            mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        }
+
+#if PLY_USE_AVX2
+        const __m256i mask256 = _mm256_broadcastsi128_si256(mask);
+        for (; i + 32u <= size; i += 32u) {
+            const __m256i v = _mm256_loadu_si256((const __m256i*)(mem + i));
+            _mm256_storeu_si256((__m256i*)(mem + i), _mm256_shuffle_epi8(v, mask256));
+        }
+#endif
+        for (; i + 16u <= size; i += 16u) {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(mem + i));
+            _mm_storeu_si128((__m128i*)(mem + i), _mm_shuffle_epi8(v, mask));
+        }
+    }
+#endif /* PLY_USE_SSSE3 */
+
+    switch (scalarSize)
+    {
+    case 2:
+        for (; i < size; i += 2u) {
+            U16 v;
+            memcpy(&v, mem + i, sizeof(v));
+            v = PLY_BYTESWAP16(v);
+            memcpy(mem + i, &v, sizeof(v));
+        }
+        break;
+    case 4:
+        for (; i < size; i += 4u) {
+            U32 v;
+            memcpy(&v, mem + i, sizeof(v));
+            v = PLY_BYTESWAP32(v);
+            memcpy(mem + i, &v, sizeof(v));
+        }
+        break;
+    case 8:
+        for (; i < size; i += 8u) {
+            U64 v;
+            memcpy(&v, mem + i, sizeof(v));
+            v = PLY_BYTESWAP64(v);
+            memcpy(mem + i, &v, sizeof(v));
+        }
+        break;
+    default: /* single bytes have no byte order */
+        break;
+    }
+}
+
+/* swaps the bytes of count values of scalarSize bytes, each stride bytes apart */
+static void swapBytesStrided(U8* mem, const U64 count, const U64 stride, const U8 scalarSize)
+{
+    if (stride == scalarSize) {
+        swapBytesRun(mem, count, scalarSize);
+        return;
+    }
+
+    U64 i = 0u;
+    switch (scalarSize)
+    {
+    case 2:
+        for (; i < count; ++i, mem += stride) {
+            U16 v;
+            memcpy(&v, mem, sizeof(v));
+            v = PLY_BYTESWAP16(v);
+            memcpy(mem, &v, sizeof(v));
+        }
+        break;
+    case 4:
+        for (; i < count; ++i, mem += stride) {
+            U32 v;
+            memcpy(&v, mem, sizeof(v));
+            v = PLY_BYTESWAP32(v);
+            memcpy(mem, &v, sizeof(v));
+        }
+        break;
+    case 8:
+        for (; i < count; ++i, mem += stride) {
+            U64 v;
+            memcpy(&v, mem, sizeof(v));
+            v = PLY_BYTESWAP64(v);
+            memcpy(mem, &v, sizeof(v));
+        }
+        break;
+    default: /* single bytes have no byte order */
+        break;
+    }
+}
+
+/* swaps a single value in place */
+typedef void (*PlySwapFn)(U8* mem);
+/* reads a list count that is in host byte order */
+typedef U64 (*PlyReadCountFn)(const U8* src);
+/* parses the ASCII value at str into dst and returns the number of characters read, 0 if it is not a number of that type */
+typedef U8 (*PlyAsciiDecodeFn)(const char* str, const U64 avail, U8* dst);
+
+static void swapNone(U8* mem) { (void)mem; }
+static void swapBytes2(U8* mem) { U16 v; memcpy(&v, mem, sizeof(v)); v = PLY_BYTESWAP16(v); memcpy(mem, &v, sizeof(v)); }
+static void swapBytes4(U8* mem) { U32 v; memcpy(&v, mem, sizeof(v)); v = PLY_BYTESWAP32(v); memcpy(mem, &v, sizeof(v)); }
+static void swapBytes8(U8* mem) { U64 v; memcpy(&v, mem, sizeof(v)); v = PLY_BYTESWAP64(v); memcpy(mem, &v, sizeof(v)); }
+
+/* list counts are read the same way PlyScaleBytesToU64 reads them */
+static U64 readCountChar(const U8* src) { I8 v; memcpy(&v, src, sizeof(v)); return (U64)v; }
+static U64 readCountUChar(const U8* src) { return *src; }
+static U64 readCountShort(const U8* src) { I16 v; memcpy(&v, src, sizeof(v)); return (U64)v; }
+static U64 readCountUShort(const U8* src) { U16 v; memcpy(&v, src, sizeof(v)); return v; }
+static U64 readCountInt(const U8* src) { I32 v; memcpy(&v, src, sizeof(v)); return (U64)v; }
+static U64 readCountUInt(const U8* src) { U32 v; memcpy(&v, src, sizeof(v)); return v; }
+static U64 readCountFloat(const U8* src) { return PlyScaleBytesToU64(src, PLY_SCALAR_TYPE_FLOAT); }
+static U64 readCountDouble(const U8* src) { return PlyScaleBytesToU64(src, PLY_SCALAR_TYPE_DOUBLE); }
+
+PLY_INLINE PlySwapFn getSwapFn(const U8 scalarSize)
+{
+    switch (scalarSize)
+    {
+    case 2: return swapBytes2;
+    case 4: return swapBytes4;
+    case 8: return swapBytes8;
+    default: return swapNone;
+    }
+}
+
+PLY_INLINE PlyReadCountFn getReadCountFn(const enum PlyScalarType type)
+{
+    switch (type)
+    {
+    case PLY_SCALAR_TYPE_CHAR: return readCountChar;
+    case PLY_SCALAR_TYPE_SHORT: return readCountShort;
+    case PLY_SCALAR_TYPE_USHORT: return readCountUShort;
+    case PLY_SCALAR_TYPE_INT: return readCountInt;
+    case PLY_SCALAR_TYPE_UINT: return readCountUInt;
+    case PLY_SCALAR_TYPE_FLOAT: return readCountFloat;
+    case PLY_SCALAR_TYPE_DOUBLE: return readCountDouble;
+    default: return readCountUChar;
+    }
+}
+
+/* reads a value in host byte order as a double, the normalized variants map integers to [-1, 1] or [0, 1] */
+typedef double (*PlyLoadValueFn)(const U8* src);
+/* writes a double as the type of a PlyPropertyBinding, rounded to the nearest integer and clamped to the range of the type */
+typedef void (*PlyStoreValueFn)(U8* dst, const double value);
+
+static double loadChar(const U8* src) { I8 v; memcpy(&v, src, sizeof(v)); return v; }
+static double loadUChar(const U8* src) { return *src; }
+static double loadShort(const U8* src) { I16 v; memcpy(&v, src, sizeof(v)); return v; }
+static double loadUShort(const U8* src) { U16 v; memcpy(&v, src, sizeof(v)); return v; }
+static double loadInt(const U8* src) { I32 v; memcpy(&v, src, sizeof(v)); return v; }
+static double loadUInt(const U8* src) { U32 v; memcpy(&v, src, sizeof(v)); return v; }
+static double loadFloat(const U8* src) { float v; memcpy(&v, src, sizeof(v)); return v; }
+static double loadDouble(const U8* src) { double v; memcpy(&v, src, sizeof(v)); return v; }
+
+/* signed types are normalized like snorm, where both the smallest and the second smallest value become -1 */
+static double loadCharNormalized(const U8* src) { const double v = loadChar(src) / 127.0; return v < -1.0 ? -1.0 : v; }
+static double loadUCharNormalized(const U8* src) { return loadUChar(src) / 255.0; }
+static double loadShortNormalized(const U8* src) { const double v = loadShort(src) / 32767.0; return v < -1.0 ? -1.0 : v; }
+static double loadUShortNormalized(const U8* src) { return loadUShort(src) / 65535.0; }
+static double loadIntNormalized(const U8* src) { const double v = loadInt(src) / 2147483647.0; return v < -1.0 ? -1.0 : v; }
+static double loadUIntNormalized(const U8* src) { return loadUInt(src) / 4294967295.0; }
+
+/* NaN becomes lo */
+PLY_INLINE double clampBoundValue(const double value, const double lo, const double hi)
+{
+    return value > hi ? hi : (value >= lo ? value : lo);
+}
+
+/* rounds half away from zero, value must already be clamped to the range of the destination type */
+PLY_INLINE I64 roundBoundValue(const double value)
+{
+    return (I64)(value < 0.0 ? value - 0.5 : value + 0.5);
+}
+
+static void storeChar(U8* dst, const double value) { const I8 v = (I8)roundBoundValue(clampBoundValue(value, -128.0, 127.0)); memcpy(dst, &v, sizeof(v)); }
+static void storeUChar(U8* dst, const double value) { *dst = (U8)roundBoundValue(clampBoundValue(value, 0.0, 255.0)); }
+static void storeShort(U8* dst, const double value) { const I16 v = (I16)roundBoundValue(clampBoundValue(value, -32768.0, 32767.0)); memcpy(dst, &v, sizeof(v)); }
+static void storeUShort(U8* dst, const double value) { const U16 v = (U16)roundBoundValue(clampBoundValue(value, 0.0, 65535.0)); memcpy(dst, &v, sizeof(v)); }
+static void storeInt(U8* dst, const double value) { const I32 v = (I32)roundBoundValue(clampBoundValue(value, -2147483648.0, 2147483647.0)); memcpy(dst, &v, sizeof(v)); }
+static void storeUInt(U8* dst, const double value) { const U32 v = (U32)roundBoundValue(clampBoundValue(value, 0.0, 4294967295.0)); memcpy(dst, &v, sizeof(v)); }
+static void storeFloat(U8* dst, const double value) { const float v = (float)value; memcpy(dst, &v, sizeof(v)); }
+static void storeDouble(U8* dst, const double value) { memcpy(dst, &value, sizeof(value)); }
+
+static void storeCharNormalized(U8* dst, const double value) { storeChar(dst, clampBoundValue(value, -1.0, 1.0) * 127.0); }
+static void storeUCharNormalized(U8* dst, const double value) { storeUChar(dst, clampBoundValue(value, 0.0, 1.0) * 255.0); }
+static void storeShortNormalized(U8* dst, const double value) { storeShort(dst, clampBoundValue(value, -1.0, 1.0) * 32767.0); }
+static void storeUShortNormalized(U8* dst, const double value) { storeUShort(dst, clampBoundValue(value, 0.0, 1.0) * 65535.0); }
+static void storeIntNormalized(U8* dst, const double value) { storeInt(dst, clampBoundValue(value, -1.0, 1.0) * 2147483647.0); }
+static void storeUIntNormalized(U8* dst, const double value) { storeUInt(dst, clampBoundValue(value, 0.0, 1.0) * 4294967295.0); }
+
+PLY_INLINE PlyLoadValueFn getLoadValueFn(const enum PlyScalarType type, const bool normalized)
+{
+    switch (type)
+    {
+    case PLY_SCALAR_TYPE_CHAR: return normalized ? loadCharNormalized : loadChar;
+    case PLY_SCALAR_TYPE_UCHAR: return normalized ? loadUCharNormalized : loadUChar;
+    case PLY_SCALAR_TYPE_SHORT: return normalized ? loadShortNormalized : loadShort;
+    case PLY_SCALAR_TYPE_USHORT: return normalized ? loadUShortNormalized : loadUShort;
+    case PLY_SCALAR_TYPE_INT: return normalized ? loadIntNormalized : loadInt;
+    case PLY_SCALAR_TYPE_UINT: return normalized ? loadUIntNormalized : loadUInt;
+    case PLY_SCALAR_TYPE_FLOAT: return loadFloat;
+    case PLY_SCALAR_TYPE_DOUBLE: return loadDouble;
+    default: return NULL;
+    }
+}
+
+PLY_INLINE PlyStoreValueFn getStoreValueFn(const enum PlyScalarType type, const bool normalized)
+{
+    switch (type)
+    {
+    case PLY_SCALAR_TYPE_CHAR: return normalized ? storeCharNormalized : storeChar;
+    case PLY_SCALAR_TYPE_UCHAR: return normalized ? storeUCharNormalized : storeUChar;
+    case PLY_SCALAR_TYPE_SHORT: return normalized ? storeShortNormalized : storeShort;
+    case PLY_SCALAR_TYPE_USHORT: return normalized ? storeUShortNormalized : storeUShort;
+    case PLY_SCALAR_TYPE_INT: return normalized ? storeIntNormalized : storeInt;
+    case PLY_SCALAR_TYPE_UINT: return normalized ? storeUIntNormalized : storeUInt;
+    case PLY_SCALAR_TYPE_FLOAT: return storeFloat;
+    case PLY_SCALAR_TYPE_DOUBLE: return storeDouble;
+    default: return NULL;
+    }
+}
+
+/* the decode step of one property, resolved from its types once so that reading a data line does not branch on them */
+struct PlyRowStep
+{
+    PlySwapFn swapValue;
+    PlySwapFn swapCount;
+    PlyReadCountFn readCount; /* NULL for scalar properties */
+    PlyAsciiDecodeFn decodeValue; /* only set for ASCII files */
+    PlyAsciiDecodeFn decodeCount;
+    U8 scalarSize;
+    U8 listCountSize; /* 0 for scalar properties */
+    bool drop; /* the property was left out by PlyLoadInfo::propertySelections, its values are passed over but not stored */
+    U32 propertyIdx; /* index of the property once the dropped ones are removed from the element */
+    const struct PlyPropertyBinding* binding; /* where the values of a bound element go, NULL if they are passed over */
+    PlyLoadValueFn loadBound; /* both NULL if the binding has the property's type and values are copied as they are */
+    PlyStoreValueFn storeBound;
+};
+
+/* row layouts common enough to have their own decode loops, everything else runs the steps one by one */
+enum PlyRowKernel
+{
+    PLY_ROW_KERNEL_GENERIC = 0,
+    /* floats followed by uchars, like float x, y, z [nx, ny, nz] and uchar red, green, blue [alpha] */
+    PLY_ROW_KERNEL_FLOATS_AND_BYTES,
+    /* a lone list uchar int or list uchar uint, like the vertex_indices of a face */
+    PLY_ROW_KERNEL_BYTE_COUNTED_INTS
+};
+
+/* the steps of every property of an element, in order */
+struct PlyRowProgram
+{
+    struct PlyRowStep* steps;
+    U32 stepCount;
+    enum PlyRowKernel kernel;
+    U32 kernelFloatCount; /* PLY_ROW_KERNEL_FLOATS_AND_BYTES only */
+    U32 kernelByteCount;
+    bool kernelSigned; /* PLY_ROW_KERNEL_BYTE_COUNTED_INTS only, true for int values and false for uint values */
+    bool skip; /* the element's data is passed over by the row readers, and unless it is bound the element is dropped after loading */
+    const struct PlyElementBinding* binding; /* set if PlyLoadInfo::elementBindings decodes the element into a caller's buffer, which also sets skip */
+    bool projected; /* some of the element's properties are dropped */
+    const U8* source; /* where the element begins in a binary data section */
+};
+
+/* checks whether an element has one of the layouts that PlyRowKernel has a decode loop for */
+static void recognizeRowKernel(struct PlyRowProgram* program, const struct PlyElement* element)
+{
+    program->kernel = PLY_ROW_KERNEL_GENERIC;
+    program->kernelFloatCount = 0u;
+    program->kernelByteCount = 0u;
+    program->kernelSigned = false;
+    if (element->propertyCount == 0u) {
+        return;
+    }
+
+    const struct PlyProperty* first = element->properties;
+    if (element->propertyCount == 1u && first->dataType == PLY_DATA_TYPE_LIST && first->listCountType == PLY_SCALAR_TYPE_UCHAR &&
+        (first->scalarType == PLY_SCALAR_TYPE_INT || first->scalarType == PLY_SCALAR_TYPE_UINT)) {
+        program->kernel = PLY_ROW_KERNEL_BYTE_COUNTED_INTS;
+        program->kernelSigned = first->scalarType == PLY_SCALAR_TYPE_INT;
+        return;
+    }
+
+    U32 pi = 0u;
+    for (; pi < element->propertyCount; ++pi) {
+        const struct PlyProperty* property = element->properties + pi;
+        if (property->dataType != PLY_DATA_TYPE_SCALAR || property->scalarType != PLY_SCALAR_TYPE_FLOAT)
+            break;
+    }
+    const U32 floatCount = pi;
+    for (; pi < element->propertyCount; ++pi) {
+        const struct PlyProperty* property = element->properties + pi;
+        if (property->dataType != PLY_DATA_TYPE_SCALAR || property->scalarType != PLY_SCALAR_TYPE_UCHAR)
+            return;
+    }
+    if (floatCount == 0u) {
+        return;
+    }
+    program->kernel = PLY_ROW_KERNEL_FLOATS_AND_BYTES;
+    program->kernelFloatCount = floatCount;
+    program->kernelByteCount = element->propertyCount - floatCount;
+}
+
+/* returns the selection that PlyLoadInfo::propertySelections has for the element, or NULL if all of its properties are loaded */
+PLY_INLINE const struct PlyPropertySelection* findPropertySelection(const struct PlyLoadInfo* loadInfo, const char* elementName)
+{
+    if (!loadInfo || !loadInfo->propertySelections) {
+        return NULL;
+    }
+    U32 si = 0u;
+    for (; si < loadInfo->propertySelectionCount; ++si) {
+        if (strcmp(loadInfo->propertySelections[si].element, elementName) == 0) {
+            return loadInfo->propertySelections + si;
+        }
+    }
+    return NULL;
+}
+
+/* returns the binding that PlyLoadInfo::elementBindings has for the element, or NULL if it is stored in the scene */
+PLY_INLINE const struct PlyElementBinding* findElementBinding(const struct PlyLoadInfo* loadInfo, const char* elementName)
+{
+    if (!loadInfo || !loadInfo->elementBindings) {
+        return NULL;
+    }
+    U32 bi = 0u;
+    for (; bi < loadInfo->elementBindingCount; ++bi) {
+        if (strcmp(loadInfo->elementBindings[bi].element, elementName) == 0) {
+            return loadInfo->elementBindings + bi;
+        }
+    }
+    return NULL;
+}
+
+PLY_INLINE const struct PlyPropertyBinding* findPropertyBinding(const struct PlyElementBinding* binding, const char* propertyName)
+{
+    U32 i = 0u;
+    for (; i < binding->propertyCount; ++i) {
+        if (strcmp(binding->properties[i].property, propertyName) == 0) {
+            return binding->properties + i;
+        }
+    }
+    return NULL;
+}
+
+PLY_INLINE bool isPropertySelected(const struct PlyPropertySelection* selection, const char* propertyName)
+{
+    U32 i = 0u;
+    for (; i < selection->propertyCount; ++i) {
+        if (strcmp(selection->properties[i], propertyName) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* compiles a row program for every element of the scene, the programs and their steps share one allocation that is freed with plyDealloc.
+A scene without elements gets no programs. */
+static enum PlyResult compileRowPrograms(const struct PlyScene* scene, const struct PlyLoadInfo* loadInfo, struct PlyRowProgram** programsOut)
+{
+    *programsOut = NULL;
+    if (scene->elementCount == 0u) {
+        return PLY_SUCCESS;
+    }
+
+    U64 stepCount = 0u;
+    U32 ei = 0;
+    for (; ei < scene->elementCount; ++ei) {
+        stepCount += scene->elements[ei].propertyCount;
+    }
+
+    struct PlyRowProgram* programs = (struct PlyRowProgram*)plyRealloc(NULL,
+        sizeof(struct PlyRowProgram) * scene->elementCount + sizeof(struct PlyRowStep) * stepCount);
+    if (!programs) {
+        return PLY_FAILED_ALLOC_ERROR;
+    }
+
+    struct PlyRowStep* step = (struct PlyRowStep*)(programs + scene->elementCount);
+    for (ei = 0; ei < scene->elementCount; ++ei)
+    {
+        const struct PlyElement* element = scene->elements + ei;
+        programs[ei].steps = step;
+        programs[ei].stepCount = element->propertyCount;
+        recognizeRowKernel(programs + ei, element);
+        programs[ei].source = NULL;
+        programs[ei].skip = false;
+        if (loadInfo && loadInfo->elementCount != PLY_LOAD_ALL_ELEMENTS) {
+            programs[ei].skip = true;
+            U32 i = 0;
+            for (; i < loadInfo->elementCount; ++i) {
+                if (strcmp(element->name, loadInfo->elements[i]) == 0) {
+                    programs[ei].skip = false;
+                    break;
+                }
             }
+        }
+
+        /* a bound element keeps all of its properties, the unbound ones are simply not written anywhere */
+        const struct PlyElementBinding* binding = programs[ei].skip ? NULL : findElementBinding(loadInfo, element->name);
+        programs[ei].binding = binding;
+        if (binding) {
+            programs[ei].skip = true;
+            programs[ei].kernel = PLY_ROW_KERNEL_GENERIC;
+            if (element->dataLineCount > binding->dataLineCapacity || (!binding->dst && element->dataLineCount != 0u)) {
+                plyDealloc(programs);
+                return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+            }
+        }
+
+        const struct PlyPropertySelection* selection = programs[ei].skip ? NULL : findPropertySelection(loadInfo, element->name);
+        programs[ei].projected = false;
+        U32 keptCount = 0u;
+        U32 pi = 0u;
+        for (; pi < element->propertyCount; ++pi, ++step)
+        {
+            const struct PlyProperty* property = element->properties + pi;
+            const bool isList = property->dataType != PLY_DATA_TYPE_SCALAR;
+            step->drop = selection && !isPropertySelected(selection, property->name);
+            step->propertyIdx = keptCount;
+            if (step->drop) {
+                programs[ei].projected = true;
+            }
+            else {
+                ++keptCount;
+            }
+            step->scalarSize = PlyGetSizeofScalarType(property->scalarType);
+            step->listCountSize = isList ? PlyGetSizeofScalarType(property->listCountType) : 0u;
+            step->swapValue = getSwapFn(step->scalarSize);
+            step->swapCount = getSwapFn(step->listCountSize);
+            step->readCount = isList ? getReadCountFn(property->listCountType) : NULL;
+            step->decodeValue = NULL;
+            step->decodeCount = NULL;
+
+            step->binding = binding ? findPropertyBinding(binding, property->name) : NULL;
+            step->loadBound = NULL;
+            step->storeBound = NULL;
+            if (step->binding && (isList || !getStoreValueFn(step->binding->type, false) || !getLoadValueFn(property->scalarType, false))) {
+                plyDealloc(programs);
+                return PLY_DATA_TYPE_MISMATCH_ERROR;
+            }
+            if (step->binding && step->binding->type != property->scalarType) {
+                step->loadBound = getLoadValueFn(property->scalarType, step->binding->normalized);
+                step->storeBound = getStoreValueFn(step->binding->type, step->binding->normalized);
+            }
+        }
+        if (programs[ei].projected) {
+            /* the stored rows no longer have the file's layout */
+            programs[ei].kernel = PLY_ROW_KERNEL_GENERIC;
+        }
+    }
+    *programsOut = programs;
+    return PLY_SUCCESS;
+}
+
+/* reads a binary list count, correcting its byte order if needed */
+PLY_INLINE U64 readBinaryListCount(const U8* src, const struct PlyRowStep* step, const bool swap)
+{
+    U8 tmp[8];
+    memcpy(tmp, src, step->listCountSize);
+    if (swap) {
+        step->swapCount(tmp);
+    }
+    return step->readCount(tmp);
+}
+
+/* swaps every value of a data line that has already been copied out of the file into host byte order */
+static void swapDataLine(U8* line, const struct PlyRowProgram* program)
+{
+    if (program->kernel == PLY_ROW_KERNEL_BYTE_COUNTED_INTS) {
+        swapBytesRun(line + 1, *line, 4u);
+        return;
+    }
+
+    const struct PlyRowStep* step = program->steps;
+    const struct PlyRowStep* stepsEnd = step + program->stepCount;
+    for (; step < stepsEnd; ++step)
+    {
+        if (!step->readCount) {
+            step->swapValue(line);
+            line += step->scalarSize;
+        }
+        else {
+            step->swapCount(line);
+            const U64 listCount = step->readCount(line);
+            line += step->listCountSize;
+
+            swapBytesRun(line, listCount, step->scalarSize);
+            line += listCount * step->scalarSize;
+        }
+    }
+}
+
+/* stores the offset of a property from the beginning of data line dli, if the property has dataLineOffsets.
+The offsets are U32, so longer data lines can not be loaded. */
+PLY_INLINE enum PlyResult setDataLineOffset(U32* dataLineOffsets, const U64 dli, const U64 lineOffset)
+{
+    if (lineOffset > UINT32_MAX) {
+        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+    }
+    if (dataLineOffsets) {
+        dataLineOffsets[dli] = (U32)lineOffset;
+    }
+    return PLY_SUCCESS;
+}
+
+/* copies and byte swaps the data lines [firstLine, firstLine + lineCount) of a sized element.
+src and dst point to the first byte of the element in the file and in the element data. */
+static enum PlyResult fillBinaryDataLines(struct PlyElement* element, const struct PlyRowProgram* program, const U8* src, U8* dst, const U64 firstLine, const U64 lineCount, const bool copy, const bool swap, const bool compact)
+{
+    const U64 stride = element->dataLineStride;
+    if (lineCount == 0u) {
+        return PLY_SUCCESS;
+    }
+
+    if (stride != 0u)
+    {
+        const U64 begin = firstLine * stride;
+        const U64 size = lineCount * stride;
+        const U64 srcStride = getBinaryElementFileSize(element) / element->dataLineCount;
+        if (copy && srcStride == stride) {
+            memcpy(dst + begin, src + begin, size);
+        }
+        else if (copy) {
+            /* dense list, drop the count in front of every list */
+            const U64 listCountSize = srcStride - stride;
+            U64 dli = firstLine;
+            for (; dli < firstLine + lineCount; ++dli) {
+                memcpy(dst + dli * stride, src + dli * srcStride + listCountSize, stride);
+            }
+        }
+
+        U32 pi = 0u;
+        if (swap) {
+            const U8 uniformSize = getUniformScalarSize(element);
+            if (uniformSize != 0u) {
+                /* every value has the same size, so the rows are one run of values */
+                swapBytesRun(dst + begin, size / uniformSize, uniformSize);
+            }
+            else if (program->kernel == PLY_ROW_KERNEL_FLOATS_AND_BYTES) {
+                /* one pass over the rows, the bytes after the floats have no byte order */
+                U8* line = dst + begin;
+                U8* linesEnd = line + size;
+                const U32 floatCount = program->kernelFloatCount;
+                for (; line < linesEnd; line += stride) {
+                    U32 fi = 0u;
+                    for (; fi < floatCount; ++fi) {
+                        swapBytes4(line + (U64)fi * 4u);
+                    }
+                }
+            }
+            else {
+                for (pi = 0; pi < element->propertyCount; ++pi) {
+                    const struct PlyProperty* property = element->properties + pi;
+                    const U8 scalarSize = PlyGetSizeofScalarType(property->scalarType);
+                    U8* values = dst + begin + property->dataLineOffset;
+                    if (property->dataType == PLY_DATA_TYPE_SCALAR) {
+                        swapBytesStrided(values, lineCount, stride, scalarSize);
+                        continue;
+                    }
+
+                    /* list with a fixed arity */
+                    if (!property->denseList) {
+                        const U8 listCountSize = PlyGetSizeofScalarType(property->listCountType);
+                        swapBytesStrided(values, lineCount, stride, listCountSize);
+                        values += listCountSize;
+                    }
+                    U32 ai = 0u;
+                    for (; ai < property->listArity; ++ai) {
+                        swapBytesStrided(values + (U64)ai * scalarSize, lineCount, stride, scalarSize);
+                    }
+                }
+            }
+        }
+
+        if (!compact) {
+            U64 dli = firstLine;
+            for (; dli < firstLine + lineCount; ++dli) {
+                element->dataLineBegins[dli] = dli * stride;
+            }
+            for (pi = 0; pi < element->propertyCount; ++pi) {
+                struct PlyProperty* property = element->properties + pi;
+                for (dli = firstLine; dli < firstLine + lineCount; ++dli) {
+                    property->dataLineOffsets[dli] = property->dataLineOffset;
+                }
+            }
+        }
+        return PLY_SUCCESS;
+    }
+
+    /* element with lists, dataLineBegins was filled while sizing the element */
+    const U64 begin = element->dataLineBegins[firstLine];
+    const U64 end = firstLine + lineCount < element->dataLineCount ? element->dataLineBegins[firstLine + lineCount] : element->dataSize;
+    if (copy) {
+        memcpy(dst + begin, src + begin, end - begin);
+    }
+    U64 dli = firstLine;
+    if (swap) {
+        for (; dli < firstLine + lineCount; ++dli) {
+            swapDataLine(dst + element->dataLineBegins[dli], program);
+        }
+    }
+
+    /* the list counts are in host byte order now, so the property offsets can be read back from the copied lines */
+    if (element->properties[0].dataLineOffsets) {
+        for (dli = firstLine; dli < firstLine + lineCount; ++dli) {
+            const U8* lineBegin = dst + element->dataLineBegins[dli];
+            const U8* line = lineBegin;
+            U32 pi = 0u;
+            for (; pi < program->stepCount; ++pi) {
+                const struct PlyRowStep* step = program->steps + pi;
+                const enum PlyResult r = setDataLineOffset(element->properties[pi].dataLineOffsets, dli, line - lineBegin);
+                if (r != PLY_SUCCESS) {
+                    return r;
+                }
+                if (!step->readCount) {
+                    line += step->scalarSize;
+                }
+                else {
+                    const U64 listCount = step->readCount(line);
+                    line += step->listCountSize + listCount * step->scalarSize;
+                }
+            }
+        }
+    }
+    return PLY_SUCCESS;
+}
+
+/* checks whether every list of an element made of a single list property has the same count as the first one.
+If it does, the element gets a dataLineStride like a scalar only element and the property's listArity is set.
+If dense is true, the counts will be dropped and the stride only covers the list values. */
+static bool detectUniformListArity(struct PlyElement* element, const struct PlyRowProgram* program, const U8* src, const U8* dataLast, const bool swap, const bool dense)
+{
+    struct PlyProperty* property = element->properties;
+    const U8 listCountSize = PlyGetSizeofScalarType(property->listCountType);
+    const U8 scalarSize = PlyGetSizeofScalarType(property->scalarType);
+    const U64 remaining = (U64)(dataLast - src) + 1;
+    if (element->dataLineCount == 0u || listCountSize > remaining) {
+        return false;
+    }
+
+    const U64 arity = readBinaryListCount(src, program->steps, swap);
+    if (arity > UINT32_MAX) {
+        return false;
+    }
+    const U64 stride = listCountSize + arity * scalarSize;
+    if (stride > UINT32_MAX || element->dataLineCount > remaining / stride) {
+        return false;
+    }
+
+    /* speculate that the first count repeats every stride bytes and compare the raw count bytes against it */
+    const U8* count = src + stride;
+    const U8* countsEnd = src + stride * element->dataLineCount;
+    if (listCountSize == 1) {
+        const U8 first = *src;
+        for (; count < countsEnd; count += stride) {
+            if (*count != first) {
+                return false;
+            }
+        }
+    }
+    else {
+        for (; count < countsEnd; count += stride) {
+            if (memcmp(count, src, listCountSize) != 0) {
+                return false;
+            }
+        }
+    }
+
+    property->listArity = (U32)arity;
+    property->denseList = dense && arity != 0u;
+    property->dataLineOffset = 0u;
+    element->dataLineStride = (U32)(property->denseList ? arity * scalarSize : stride);
+    return true;
+}
+
+/* sizes an element made of a single list property, such as the vertex_indices of a face, by only reading its list counts.
+Fills dataLineBegins and dataSize, the data itself is copied later by fillBinaryDataLines. */
+static enum PlyResult sizeSingleListElement(struct PlyElement* element, const struct PlyRowProgram* program, const U8* src, const U8* dataLast, const bool swap)
+{
+    const struct PlyRowStep* step = program->steps;
+    const U8 listCountSize = step->listCountSize;
+    const U8 scalarSize = step->scalarSize;
+    const U8* elementBegin = src;
+
+    U64 dli = 0;
+    for (; dli < element->dataLineCount; ++dli)
+    {
+        element->dataLineBegins[dli] = src - elementBegin;
+        if (listCountSize > (U64)(dataLast - src) + 1) {
+            return PLY_MALFORMED_DATA_ERROR;
+        }
+        const U64 listCount = listCountSize == 1 ? *src : readBinaryListCount(src, step, swap);
+        src += listCountSize;
+
+        /* prevent overflow and out of bounds reads */
+        if (listCount > ((U64)(dataLast - src) + 1) / scalarSize) {
+            return PLY_MALFORMED_FILE_ERROR;
+        }
+        src += listCount * scalarSize;
+    }
+    element->dataSize = src - elementBegin;
+    return PLY_SUCCESS;
+}
+
+/* moves src past the data of an element that was excluded by PlyLoadInfo::elements.
+Elements with a dataLineStride are skipped in O(1), elements with lists only have their counts read. */
+static enum PlyResult skipBinaryElement(const struct PlyElement* element, const struct PlyRowProgram* program, const U8** srcInOut, const U8* dataLast, const bool swap)
+{
+    const U8* src = *srcInOut;
+    const U64 stride = element->dataLineStride;
+    if (stride != 0u) {
+        if (element->dataLineCount > ((U64)(dataLast - src) + 1) / stride) {
+            return PLY_MALFORMED_DATA_ERROR;
+        }
+        *srcInOut = src + stride * element->dataLineCount;
+        return PLY_SUCCESS;
+    }
+
+    U64 dli = 0;
+    for (; dli < element->dataLineCount; ++dli)
+    {
+        U32 pi = 0u;
+        for (; pi < program->stepCount; ++pi)
+        {
+            const struct PlyRowStep* step = program->steps + pi;
+            if (!step->readCount) {
+                if (step->scalarSize > (U64)(dataLast - src) + 1) {
+                    return PLY_MALFORMED_DATA_ERROR;
+                }
+                src += step->scalarSize;
+                continue;
+            }
+
+            if (step->listCountSize > (U64)(dataLast - src) + 1) {
+                return PLY_MALFORMED_DATA_ERROR;
+            }
+            const U64 listCount = readBinaryListCount(src, step, swap);
+            src += step->listCountSize;
+            if (listCount > ((U64)(dataLast - src) + 1) / step->scalarSize) {
+                return PLY_MALFORMED_FILE_ERROR;
+            }
+            src += listCount * step->scalarSize;
+        }
+    }
+    *srcInOut = src;
+    return PLY_SUCCESS;
+}
+
+/* number of data lines whose values are gathered one property after another, few enough for the lines to stay in cache */
+#define PLY_COLUMN_BLOCK_LINES ((U64)256u)
+
+/* writes a value in host byte order to data line dli of the step's binding */
+PLY_INLINE void writeBoundValue(const struct PlyRowProgram* program, const struct PlyRowStep* step, const U64 dli, const U8* value)
+{
+    U8* dst = (U8*)program->binding->dst + dli * step->binding->stride + step->binding->offset;
+    if (step->storeBound) {
+        step->storeBound(dst, step->loadBound(value));
+    }
+    else {
+        memcpy(dst, value, step->scalarSize);
+    }
+}
+
+/* decodes every data line of an element with a PlyElementBinding from a binary file straight into the caller's buffer,
+and moves src past the element. Data lines without lists are written a block of lines at a time, one bound property after another. */
+static enum PlyResult readBoundBinaryElement(const struct PlyElement* element, const struct PlyRowProgram* program, const U8** srcInOut, const U8* dataLast, const bool swap)
+{
+    const U8* src = *srcInOut;
+    U8 value[8];
+    const U64 stride = element->dataLineStride;
+    if (stride != 0u)
+    {
+        if (element->dataLineCount > ((U64)(dataLast - src) + 1) / stride) {
+            return PLY_MALFORMED_DATA_ERROR;
+        }
+        U64 blockBegin = 0u;
+        for (; blockBegin < element->dataLineCount; blockBegin += PLY_COLUMN_BLOCK_LINES)
+        {
+            const U64 blockEnd = min(blockBegin + PLY_COLUMN_BLOCK_LINES, (U64)element->dataLineCount);
+            U32 si = 0u;
+            for (; si < program->stepCount; ++si)
+            {
+                const struct PlyRowStep* step = program->steps + si;
+                if (!step->binding) {
+                    continue;
+                }
+                const U8* line = src + blockBegin * stride + element->properties[si].dataLineOffset;
+                U64 dli = blockBegin;
+                for (; dli < blockEnd; ++dli, line += stride) {
+                    memcpy(value, line, step->scalarSize);
+                    if (swap) {
+                        step->swapValue(value);
+                    }
+                    writeBoundValue(program, step, dli, value);
+                }
+            }
+        }
+        *srcInOut = src + stride * element->dataLineCount;
+        return PLY_SUCCESS;
+    }
+
+    U64 dli = 0;
+    for (; dli < element->dataLineCount; ++dli)
+    {
+        U32 si = 0u;
+        for (; si < program->stepCount; ++si)
+        {
+            const struct PlyRowStep* step = program->steps + si;
+            if (!step->readCount) {
+                if (step->scalarSize > (U64)(dataLast - src) + 1) {
+                    return PLY_MALFORMED_DATA_ERROR;
+                }
+                if (step->binding) {
+                    memcpy(value, src, step->scalarSize);
+                    if (swap) {
+                        step->swapValue(value);
+                    }
+                    writeBoundValue(program, step, dli, value);
+                }
+                src += step->scalarSize;
+                continue;
+            }
+
+            if (step->listCountSize > (U64)(dataLast - src) + 1) {
+                return PLY_MALFORMED_DATA_ERROR;
+            }
+            const U64 listCount = readBinaryListCount(src, step, swap);
+            src += step->listCountSize;
+            if (listCount > ((U64)(dataLast - src) + 1) / step->scalarSize) {
+                return PLY_MALFORMED_FILE_ERROR;
+            }
+            src += listCount * step->scalarSize;
+        }
+    }
+    *srcInOut = src;
+    return PLY_SUCCESS;
+}
+
+/* copies the selected properties of every data line of an element narrowed by PlyLoadInfo::propertySelections, one value at a time */
+static enum PlyResult readProjectedBinaryElement(struct PlyElement* element, const struct PlyRowProgram* program, const U8** srcInOut, const U8* dataLast, U8* dst, const bool swap)
+{
+    const U8* src = *srcInOut;
+    U8* elementBegin = dst;
+    U64 dli = 0;
+    for (; dli < element->dataLineCount; ++dli)
+    {
+        U8* lineBegin = dst;
+        if (element->dataLineBegins) {
+            element->dataLineBegins[dli] = lineBegin - elementBegin;
+        }
+
+        U32 pi = 0u;
+        for (; pi < program->stepCount; ++pi)
+        {
+            const struct PlyRowStep* step = program->steps + pi;
+            U64 listCount = 0u;
+            U64 size = step->scalarSize;
+            if (step->readCount) {
+                if (step->listCountSize > (U64)(dataLast - src) + 1) {
+                    return PLY_MALFORMED_DATA_ERROR;
+                }
+                listCount = readBinaryListCount(src, step, swap);
+                if (listCount > ((U64)(dataLast - src) + 1 - step->listCountSize) / step->scalarSize) {
+                    return PLY_MALFORMED_FILE_ERROR;
+                }
+                size = step->listCountSize + listCount * step->scalarSize;
+            }
+            else if (size > (U64)(dataLast - src) + 1) {
+                return PLY_MALFORMED_DATA_ERROR;
+            }
+
+            if (!step->drop) {
+                const enum PlyResult r = setDataLineOffset(element->properties[step->propertyIdx].dataLineOffsets, dli, dst - lineBegin);
+                if (r != PLY_SUCCESS) {
+                    return r;
+                }
+
+                memcpy(dst, src, size);
+                if (swap && !step->readCount) {
+                    step->swapValue(dst);
+                }
+                else if (swap) {
+                    step->swapCount(dst);
+                    swapBytesRun(dst + step->listCountSize, listCount, step->scalarSize);
+                }
+                dst += size;
+            }
+            src += size;
+        }
+    }
+    element->dataSize = dst - elementBegin;
+    *srcInOut = src;
+    return PLY_SUCCESS;
+}
+
+/* a range of data lines of one element that one thread copies and swaps */
+struct PlyBinaryFillJob
+{
+    struct PlyElement* element;
+    const struct PlyRowProgram* program;
+    const U8* src;
+    U8* dst;
+    U64 firstLine;
+    U64 lineCount;
+    enum PlyResult result;
+};
+
+struct PlyBinaryFillContext
+{
+    struct PlyBinaryFillJob* jobs;
+    U32 jobCount;
+    U32 workerCount;
+    bool copy;
+    bool swap;
+    bool compact;
+};
+
+static void binaryFillWorker(void* ctx, U32 workerIdx)
+{
+    const struct PlyBinaryFillContext* fill = (const struct PlyBinaryFillContext*)ctx;
+    /* jobs are roughly the same size, so they are dealt out round robin */
+    U32 ji = workerIdx;
+    for (; ji < fill->jobCount; ji += fill->workerCount) {
+        struct PlyBinaryFillJob* job = fill->jobs + ji;
+        job->result = fillBinaryDataLines(job->element, job->program, job->src, job->dst, job->firstLine, job->lineCount, fill->copy, fill->swap, fill->compact);
+    }
+}
+
+/* smallest amount of element data that is worth handing to another thread */
+#define PLY_MIN_PARALLEL_FILL_SIZE ((U64)1u << 20u)
+
+/* splits the already sized elements into jobs of similar size and fills them on threadCount threads */
+static enum PlyResult fillBinaryElementsParallel(struct PlyScene* scene, const struct PlyRowProgram* programs, const bool copy, const bool swap, const bool compact, U32 threadCount)
+{
+    U64 totalSize = 0u;
+    U32 ei = 0;
+    for (; ei < scene->elementCount; ++ei) {
+        totalSize += scene->elements[ei].dataSize;
+    }
+
+    if (threadCount > PLY_MAX_THREADS) {
+        threadCount = PLY_MAX_THREADS;
+    }
+    if (totalSize / PLY_MIN_PARALLEL_FILL_SIZE < threadCount) {
+        threadCount = (U32)(totalSize / PLY_MIN_PARALLEL_FILL_SIZE);
+    }
+    if (threadCount < 1u) {
+        threadCount = 1u;
+    }
+
+    /* several jobs per thread so that elements of different sizes still balance out */
+    const U64 targetJobSize = max(totalSize / ((U64)threadCount * 4u), PLY_MIN_PARALLEL_FILL_SIZE);
+    U64 maxJobCount = 0u;
+    for (ei = 0; ei < scene->elementCount; ++ei) {
+        maxJobCount += scene->elements[ei].dataSize / targetJobSize + 1u;
+    }
+
+    struct PlyBinaryFillJob* jobs = (struct PlyBinaryFillJob*)plyRealloc(NULL, sizeof(struct PlyBinaryFillJob) * maxJobCount);
+    if (!jobs) {
+        return PLY_FAILED_ALLOC_ERROR;
+    }
+
+    U32 jobCount = 0u;
+    for (ei = 0; ei < scene->elementCount; ++ei)
+    {
+        struct PlyElement* element = scene->elements + ei;
+        const U64 lineCount = element->dataLineCount;
+        if (lineCount != 0u && !programs[ei].skip && !programs[ei].projected)
+        {
+            const U64 elementJobCount = element->dataSize / targetJobSize + 1u;
+            const U64 linesPerJob = (lineCount + elementJobCount - 1u) / elementJobCount;
+
+            U64 firstLine = 0u;
+            while (firstLine < lineCount) {
+                struct PlyBinaryFillJob* job = jobs + jobCount++;
+                job->element = element;
+                job->program = programs + ei;
+                job->src = programs[ei].source;
+                job->dst = (U8*)element->data;
+                job->firstLine = firstLine;
+                job->lineCount = min(linesPerJob, lineCount - firstLine);
+                firstLine += job->lineCount;
+            }
+        }
+    }
+
+    struct PlyBinaryFillContext fill;
+    fill.jobs = jobs;
+    fill.jobCount = jobCount;
+    fill.workerCount = min(threadCount, jobCount);
+    fill.copy = copy;
+    fill.swap = swap;
+    fill.compact = compact;
+
+    runParallel(binaryFillWorker, &fill, fill.workerCount);
+
+    enum PlyResult r = PLY_SUCCESS;
+    U32 ji = 0u;
+    for (; ji < jobCount && r == PLY_SUCCESS; ++ji) {
+        r = jobs[ji].result;
+    }
+    plyDealloc(jobs);
+    return r;
+}
+
+static enum PlyResult readDataBinary(struct PlyScene* scene, struct PlyRowProgram* programs, const U8* dataBegin, const U8* dataLast, const struct PlyLoadInfo* loadInfo)
+{
+    if (dataBegin > dataLast + 1) {
+        return PLY_GENERIC_ERROR;
+    }
+    if (scene->elementCount == 0)
+        return PLY_SUCCESS;
+
+    const bool compact = loadInfo && loadInfo->compactDataLines;
+    const bool swap = PlyGetSystemEndianness() != scene->format;
+    /* narrowed elements are gathered into their own rows, so the file data can not be used as is */
+    bool projected = false;
+    U32 ei = 0;
+    for (; ei < scene->elementCount; ++ei) {
+        projected = projected || programs[ei].projected;
+    }
+    const bool borrow = loadInfo && loadInfo->borrowMemory && (!swap || loadInfo->borrowedMemoryIsWritable) && !projected;
+    /* with several threads the elements are only sized here, then copied and swapped in parallel once every offset is known */
+    const U32 threadCount = loadInfo ? loadInfo->threadCount : 0u;
+    const bool parallel = threadCount > 1u && (!borrow || swap || !compact);
+    /* dropping list counts rewrites the data, so it is not done to borrowed memory */
+    const bool dense = loadInfo && loadInfo->denseLists && !borrow;
+
+    /* the element data is stored exactly as it is laid out in the file, thus it can never be larger than the data section */
+    const U64 dataSize = (dataLast - dataBegin) + 1;
+    if (dataSize == 0) {
+        for (ei = 0; ei < scene->elementCount; ++ei) {
+            if (scene->elements[ei].dataLineCount != 0) {
+                return PLY_MALFORMED_DATA_ERROR;
+            }
+        }
+        return PLY_SUCCESS; /*nothing to allocate*/
+    }
+
+    if (borrow) {
+        /* the element data will be the file data itself */
+        scene->sharedElementData = (void*)dataBegin;
+        scene->borrowsElementData = true;
+    }
+    else {
+        scene->sharedElementData = plyRealloc(NULL, dataSize);
+        if (!scene->sharedElementData) {
+            return PLY_FAILED_ALLOC_ERROR;
+        }
+    }
+
+    const U8* src = dataBegin;
+    U8* dst = (U8*)scene->sharedElementData;
+
+    for (ei = 0; ei < scene->elementCount; ++ei)
+    {
+        struct PlyElement* element = scene->elements + ei;
+        struct PlyRowProgram* program = programs + ei;
+        if (borrow) {
+            dst = (U8*)src;
+        }
+        program->source = src;
+        element->data = dst;
+        element->dataSize = 0u;
+        if (element->dataLineCount == 0) {
+            continue; /* empty element (idk if this is permitted by the standard or not) */
+        }
+
+        enum PlyResult r = setElementLayout(element);
+        if (r != PLY_SUCCESS)
+            return r;
+
+        if (program->skip) {
+            /* only the size of an excluded element is needed, to find where the next one begins. A bound element is decoded on the way. */
+            r = program->binding ? readBoundBinaryElement(element, program, &src, dataLast, swap) : skipBinaryElement(element, program, &src, dataLast, swap);
+            if (r != PLY_SUCCESS)
+                return r;
+            continue;
+        }
+
+        if (program->projected) {
+            if (allocateDataLinesForElement(scene, element, compact) != PLY_SUCCESS)
+                return PLY_FAILED_ALLOC_ERROR;
+            r = readProjectedBinaryElement(element, program, &src, dataLast, dst, swap);
+            if (r != PLY_SUCCESS)
+                return r;
+            dst += element->dataSize;
+            continue;
+        }
+
+        /* a lone list property with the same count on every data line has a fixed stride as well */
+        if (element->dataLineStride == 0u && element->propertyCount == 1u) {
+            detectUniformListArity(element, program, src, dataLast, swap, dense);
+        }
 
+        /* create data lines for element and all its properties*/
+        if (allocateDataLinesForElement(scene, element, compact) != PLY_SUCCESS)
+            return PLY_FAILED_ALLOC_ERROR;
 
-            /*look for binary_little_endian keyword*/
-            i = strlen("format");
-            for (; i < lineLen; ++i) {
-                if (strneql(line + i, "binary_little_endian", min(strlen("binary_little_endian"), lineLen - i)) == true)
-                {
-                    scene->format = PLY_FORMAT_BINARY_LITTLE_ENDIAN;
-                    formatEnd = line + i + strlen("binary_little_endian");
-                    goto getVersion;
-                }
+        const U64 stride = element->dataLineStride;
+        if (stride != 0u)
+        {
+            /* every data line has the same layout so the element can be sized in O(1) and copied at once */
+            element->dataSize = stride * element->dataLineCount;
+            if (getBinaryElementFileSize(element) > (U64)(dataLast - src) + 1) {
+                return PLY_MALFORMED_DATA_ERROR;
+            }
+
+            if (!parallel) {
+                r = fillBinaryDataLines(element, program, src, dst, 0u, element->dataLineCount, !borrow, swap, compact);
+                if (r != PLY_SUCCESS)
+                    return r;
             }
 
-        getVersion:
-            /*no format was found*/
-            if (scene->format == PLY_FORMAT_UNDEFINED) {
-                return PLY_MALFORMED_HEADER_ERROR;
+            src += getBinaryElementFileSize(element);
+            dst += element->dataSize;
+            continue;
+        }
+
+        if (element->propertyCount == 1u)
+        {
+            /* a lone list, only the counts need to be read to find where each data line begins */
+            r = sizeSingleListElement(element, program, src, dataLast, swap);
+            if (r != PLY_SUCCESS)
+                return r;
+            if (!parallel) {
+                r = fillBinaryDataLines(element, program, src, dst, 0u, element->dataLineCount, !borrow, swap, compact);
+                if (r != PLY_SUCCESS)
+                    return r;
             }
+            src += element->dataSize;
+            dst += element->dataSize;
+            continue;
+        }
+
+        /* element with lists, walk each data line once to find its size and copy it while it is still in cache.
+        With several threads the property offsets are filled along with the copy instead. */
+        const U8* elementBegin = src;
+        U64 dli = 0;
+        for (; dli < element->dataLineCount; ++dli)
+        {
+            const U8* lineBegin = src;
+            element->dataLineBegins[dli] = lineBegin - elementBegin;
+
+            U32 pi = 0u;
+            for (; pi < program->stepCount; ++pi)
+            {
+                const struct PlyRowStep* step = program->steps + pi;
 
-            if (formatEnd != NULL) {
-                const char* vbegin = NULL;
-                const char* ch = formatEnd;
-                for (; ch <= lineLast; ch++) {
-                    if (isspace(*ch) == false) {
-                        vbegin = ch;
-                        break;
+                /* with several threads the offsets are only checked here and stored by fillBinaryDataLines */
+                r = setDataLineOffset(parallel ? NULL : element->properties[pi].dataLineOffsets, dli, src - lineBegin);
+                if (r != PLY_SUCCESS)
+                    return r;
+
+                if (!step->readCount)
+                {
+                    /* prevent buffer overrun */
+                    if (step->scalarSize > (U64)(dataLast - src) + 1) {
+                        return PLY_MALFORMED_DATA_ERROR;
                     }
+                    src += step->scalarSize;
                 }
-                if (vbegin == NULL) {
-                    return PLY_MALFORMED_HEADER_ERROR;
-                }
-                /*get version number(currently only v 1.0 is considered valid, unless allowAnyVersion is true)*/
-                scene->versionNumber = strtof(vbegin, NULL);
-                if ((!loadInfo || loadInfo->allowAnyVersion == false) && scene->versionNumber != 1.0)
+                else
                 {
-                    scene->versionNumber = 0.0;
-                    return PLY_UNSUPPORTED_VERSION_ERROR;
+                    if (step->listCountSize > (U64)(dataLast - src) + 1) {
+                        return PLY_MALFORMED_DATA_ERROR;
+                    }
+                    const U64 listCount = readBinaryListCount(src, step, swap);
+                    src += step->listCountSize;
+
+                    /* prevent overflow and out of bounds reads */
+                    const U64 remaining = (U64)(dataLast - src) + 1;
+                    if (listCount > remaining / step->scalarSize) {
+                        return PLY_MALFORMED_FILE_ERROR;
+                    }
+                    src += listCount * step->scalarSize;
                 }
             }
-            return PLY_SUCCESS;
-        } /*end format keyword check*/
 
+            const U64 lineSize = src - lineBegin;
+            if (!parallel) {
+                if (!borrow) {
+                    memcpy(dst, lineBegin, lineSize);
+                }
+                if (swap) {
+                    swapDataLine(dst, program);
+                }
+            }
+            dst += lineSize;
+        }
+        element->dataSize = src - elementBegin;
+    }
 
+    if (parallel) {
+        enum PlyResult r = fillBinaryElementsParallel(scene, programs, !borrow, swap, compact, threadCount);
+        if (r != PLY_SUCCESS)
+            return r;
+    }
 
+    if (borrow) {
+        return PLY_SUCCESS;
+    }
 
+    /* shrink the shared buffer if some of the data section was not needed */
+    const U64 totalAllocSize = dst - (U8*)scene->sharedElementData;
+    if (totalAllocSize == 0) {
+        plyDealloc(scene->sharedElementData);
+        scene->sharedElementData = NULL;
+        for (ei = 0; ei < scene->elementCount; ++ei) {
+            scene->elements[ei].data = NULL;
+        }
+        return PLY_SUCCESS;
+    }
+    if (totalAllocSize < dataSize) {
+        U8* oldData = (U8*)scene->sharedElementData;
+        U8* newData = (U8*)plyRealloc(oldData, totalAllocSize);
+        if (newData && newData != oldData) {
+            for (ei = 0; ei < scene->elementCount; ++ei) {
+                scene->elements[ei].data = newData + ((U8*)scene->elements[ei].data - oldData);
+            }
+        }
+        if (newData) {
+            scene->sharedElementData = newData;
+        }
+    }
 
-        c = "element ";
-        /*check for element declaration*/
-        if (strneql(line, c, min(strlen(c), lineLen))==true) 
-        {
+    return PLY_SUCCESS;
+}
 
-            *curElement = NULL;
+/* columns are aligned this much so that their values can be read with aligned vector loads */
+#define PLY_COLUMN_ALIGNMENT ((U64)64u)
 
-            /*find element name begin*/
+PLY_INLINE U64 alignColumnOffset(const U64 offset)
+{
+    return (offset + PLY_COLUMN_ALIGNMENT - 1u) & ~(PLY_COLUMN_ALIGNMENT - 1u);
+}
 
-            /*first char in the element's name*/
-            const char* elementNameBegin = NULL;
-            /*last char in the element's name*/
-            const char* elementNameLast = lineLast;
+/* size of an element's data lines if none of them holds a list, otherwise 0.
+rowsIncludeDropped tells whether the properties dropped by PlyLoadInfo::propertySelections are in the data lines, as they are in a binary file. */
+static U64 getColumnSourceStride(const struct PlyRowProgram* program, const bool rowsIncludeDropped)
+{
+    U64 stride = 0u;
+    U32 si = 0u;
+    for (; si < program->stepCount; ++si) {
+        const struct PlyRowStep* step = program->steps + si;
+        if (step->readCount) {
+            return 0u;
+        }
+        if (!step->drop || rowsIncludeDropped) {
+            stride += step->scalarSize;
+        }
+    }
+    return stride;
+}
 
-            const char* ch = line+strlen(c);
-            for (; ch <= lineLast; ++c) {
-                if (isspace(*ch) == 0) {
-                    elementNameBegin = ch;
-                    break;
-                }
+/* copies count values of scalarSize bytes that are stride bytes apart into a contiguous array */
+static void gatherStridedValues(U8* dst, const U8* src, const U64 count, const U64 stride, const U8 scalarSize)
+{
+    U64 i = 0u;
+    switch (scalarSize)
+    {
+    case 1:
+        for (; i < count; ++i, src += stride) {
+            dst[i] = *src;
+        }
+        break;
+    case 2:
+        for (; i < count; ++i, src += stride) {
+            memcpy(dst + i * 2u, src, 2u);
+        }
+        break;
+    case 4:
+        for (; i < count; ++i, src += stride) {
+            memcpy(dst + i * 4u, src, 4u);
+        }
+        break;
+    case 8:
+        for (; i < count; ++i, src += stride) {
+            memcpy(dst + i * 8u, src, 8u);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* counts the values that every kept property of an element holds and moves *srcInOut past the element's data lines.
+valueCounts is indexed like the element's properties. */
+static enum PlyResult countColumnValues(const struct PlyElement* element, const struct PlyRowProgram* program, const U8** srcInOut, const U8* dataLast, const bool swap, const bool rowsIncludeDropped, U64* valueCounts)
+{
+    const U8* src = *srcInOut;
+    U32 pi = 0u;
+    for (; pi < element->propertyCount; ++pi) {
+        valueCounts[pi] = 0u;
+    }
+
+    const U64 stride = getColumnSourceStride(program, rowsIncludeDropped);
+    if (stride != 0u) {
+        if (element->dataLineCount > ((U64)(dataLast - src) + 1) / stride) {
+            return PLY_MALFORMED_DATA_ERROR;
+        }
+        for (pi = 0; pi < element->propertyCount; ++pi) {
+            valueCounts[pi] = element->dataLineCount;
+        }
+        *srcInOut = src + stride * element->dataLineCount;
+        return PLY_SUCCESS;
+    }
+
+    U64 dli = 0;
+    for (; dli < element->dataLineCount; ++dli)
+    {
+        U32 si = 0u;
+        for (; si < program->stepCount; ++si)
+        {
+            const struct PlyRowStep* step = program->steps + si;
+            if (step->drop && !rowsIncludeDropped) {
+                continue;
             }
-            if (elementNameBegin == NULL) {
-                return PLY_MALFORMED_HEADER_ERROR;
+            if (!step->readCount) {
+                if (step->scalarSize > (U64)(dataLast - src) + 1) {
+                    return PLY_MALFORMED_DATA_ERROR;
+                }
+                if (!step->drop) {
+                    ++valueCounts[step->propertyIdx];
+                }
+                src += step->scalarSize;
+                continue;
             }
 
-         
+            if (step->listCountSize > (U64)(dataLast - src) + 1) {
+                return PLY_MALFORMED_DATA_ERROR;
+            }
+            const U64 listCount = readBinaryListCount(src, step, swap);
+            src += step->listCountSize;
+            if (listCount > ((U64)(dataLast - src) + 1) / step->scalarSize) {
+                return PLY_MALFORMED_FILE_ERROR;
+            }
+            if (!step->drop) {
+                valueCounts[step->propertyIdx] += listCount;
+            }
+            src += listCount * step->scalarSize;
+        }
+    }
+    *srcInOut = src;
+    return PLY_SUCCESS;
+}
 
+/* places the columns of an element in the column block. Like the element data of ASCII files, they are stored as offsets from the beginning of the block
+until it is allocated. */
+static void layoutColumns(struct PlyElement* element, const U64* valueCounts, U64* blockSizeInOut)
+{
+    U64 blockSize = *blockSizeInOut;
+    U32 pi = 0u;
+    for (; pi < element->propertyCount; ++pi)
+    {
+        struct PlyProperty* property = element->properties + pi;
+        blockSize = alignColumnOffset(blockSize);
+        property->columnData = (void*)blockSize;
+        blockSize += valueCounts[pi] * PlyGetSizeofScalarType(property->scalarType);
+
+        property->listOffsets = NULL;
+        if (property->dataType == PLY_DATA_TYPE_LIST) {
+            blockSize = alignColumnOffset(blockSize);
+            property->listOffsets = (U64*)blockSize;
+            blockSize += ((U64)element->dataLineCount + 1u) * sizeof(U64);
+        }
+    }
+    *blockSizeInOut = blockSize;
+}
 
-            /*find element name last*/
-            ch = elementNameBegin+1;
-            for (; ch <= lineLast; ++ch)
+/* copies the values of the data lines [firstLine, firstLine + lineCount) of an element into its columns.
+Data lines without lists are gathered a block of lines at a time, one property after another. Elements with lists can only be walked line by line,
+so they are always copied whole, with the last entry of every listOffsets used as the running end of its column. */
+static void scatterColumns(struct PlyElement* element, const struct PlyRowProgram* program, const U8* src, const U64 firstLine, const U64 lineCount, const bool swap, const bool rowsIncludeDropped)
+{
+    const U64 stride = getColumnSourceStride(program, rowsIncludeDropped);
+    if (stride != 0u)
+    {
+        const U64 linesEnd = firstLine + lineCount;
+        U64 blockBegin = firstLine;
+        for (; blockBegin < linesEnd; blockBegin += PLY_COLUMN_BLOCK_LINES)
+        {
+            const U64 blockLineCount = min(PLY_COLUMN_BLOCK_LINES, linesEnd - blockBegin);
+            const U8* lines = src + blockBegin * stride;
+            U32 si = 0u;
+            for (; si < program->stepCount; ++si)
             {
-                if (isspace(*ch) != 0) {
-                    elementNameLast = ch-1;
-                    break;
+                const struct PlyRowStep* step = program->steps + si;
+                if (!step->drop) {
+                    U8* values = (U8*)element->properties[step->propertyIdx].columnData + blockBegin * step->scalarSize;
+                    gatherStridedValues(values, lines, blockLineCount, stride, step->scalarSize);
+                    if (swap) {
+                        swapBytesRun(values, blockLineCount, step->scalarSize);
+                    }
+                }
+                if (!step->drop || rowsIncludeDropped) {
+                    lines += step->scalarSize;
                 }
             }
+        }
+        return;
+    }
+
+    U64 dli = 0;
+    for (; dli < element->dataLineCount; ++dli)
+    {
+        U32 si = 0u;
+        for (; si < program->stepCount; ++si)
+        {
+            const struct PlyRowStep* step = program->steps + si;
+            if (step->drop && !rowsIncludeDropped) {
+                continue;
+            }
+            struct PlyProperty* property = element->properties + step->propertyIdx;
+            if (!step->readCount) {
+                if (!step->drop) {
+                    U8* value = (U8*)property->columnData + dli * step->scalarSize;
+                    memcpy(value, src, step->scalarSize);
+                    if (swap) {
+                        step->swapValue(value);
+                    }
+                }
+                src += step->scalarSize;
+                continue;
+            }
+
+            const U64 listCount = readBinaryListCount(src, step, swap);
+            src += step->listCountSize;
+            if (!step->drop) {
+                U64* columnEnd = property->listOffsets + element->dataLineCount;
+                U8* values = (U8*)property->columnData + *columnEnd * step->scalarSize;
+                property->listOffsets[dli] = *columnEnd;
+                memcpy(values, src, listCount * step->scalarSize);
+                if (swap) {
+                    swapBytesRun(values, listCount, step->scalarSize);
+                }
+                *columnEnd += listCount;
+            }
+            src += listCount * step->scalarSize;
+        }
+    }
+}
+
+/* a range of data lines of one element that one thread copies into its columns */
+struct PlyColumnJob
+{
+    struct PlyElement* element;
+    const struct PlyRowProgram* program;
+    U64 firstLine;
+    U64 lineCount;
+};
+
+struct PlyColumnContext
+{
+    const struct PlyColumnJob* jobs;
+    U32 jobCount;
+    U32 workerCount;
+    bool swap;
+    bool rowsIncludeDropped;
+};
+
+static void columnWorker(void* ctx, U32 workerIdx)
+{
+    const struct PlyColumnContext* fill = (const struct PlyColumnContext*)ctx;
+    U32 ji = workerIdx;
+    for (; ji < fill->jobCount; ji += fill->workerCount) {
+        const struct PlyColumnJob* job = fill->jobs + ji;
+        scatterColumns(job->element, job->program, job->program->source, job->firstLine, job->lineCount, fill->swap, fill->rowsIncludeDropped);
+    }
+}
+
+/* stores the values of every kept element in columns that share one block, which is returned through blockOut.
+If fromFile is true the data lines are read from the binary data section [dataBegin, dataLast], otherwise from the rows
+that readDataASCII stored in the element data, which are then released. Elements are left without data lines. */
+static enum PlyResult buildColumns(struct PlyScene* scene, struct PlyRowProgram* programs, const U8* dataBegin, const U8* dataLast, const bool swap, const bool fromFile, U32 threadCount, void** blockOut)
+{
+    *blockOut = NULL;
+    U32 maxPropertyCount = 1u;
+    U32 ei = 0;
+    for (; ei < scene->elementCount; ++ei) {
+        maxPropertyCount = max(maxPropertyCount, scene->elements[ei].propertyCount);
+    }
+    U64* valueCounts = (U64*)plyRealloc(NULL, sizeof(U64) * maxPropertyCount);
+    if (!valueCounts) {
+        return PLY_FAILED_ALLOC_ERROR;
+    }
+
+    /* size every column, the data lines are validated along the way */
+    const U8* src = dataBegin;
+    U64 blockSize = 0u;
+    U64 totalSize = 0u;
+    U64 maxJobCount = 0u;
+    for (ei = 0; ei < scene->elementCount; ++ei)
+    {
+        struct PlyElement* element = scene->elements + ei;
+        struct PlyRowProgram* program = programs + ei;
+        if (!fromFile) {
+            src = (const U8*)element->data;
+        }
+        program->source = src;
+
+        enum PlyResult r = PLY_SUCCESS;
+        if (program->skip) {
+            if (fromFile) {
+                r = program->binding ? readBoundBinaryElement(element, program, &src, dataLast, swap) : skipBinaryElement(element, program, &src, dataLast, swap);
+            }
+        }
+        else if (element->dataLineCount == 0u || (!fromFile && element->dataSize == 0u)) {
+            /* the data lines are empty, or hold none of the element's properties */
+            memset(valueCounts, 0, sizeof(U64) * maxPropertyCount);
+            layoutColumns(element, valueCounts, &blockSize);
+        }
+        else {
+            const U8* rowsLast = fromFile ? dataLast : src + element->dataSize - 1;
+            r = countColumnValues(element, program, &src, rowsLast, swap, fromFile, valueCounts);
+            if (r == PLY_SUCCESS) {
+                element->dataSize = src - program->source;
+                layoutColumns(element, valueCounts, &blockSize);
+                totalSize += element->dataSize;
+                maxJobCount += element->dataSize / PLY_MIN_PARALLEL_FILL_SIZE + 1u;
+            }
+        }
+        if (r != PLY_SUCCESS) {
+            plyDealloc(valueCounts);
+            return r;
+        }
+    }
+    plyDealloc(valueCounts);
+
+    U8* block = NULL;
+    U8* columns = NULL;
+    if (blockSize != 0u) {
+        block = (U8*)plyRealloc(NULL, blockSize + PLY_COLUMN_ALIGNMENT - 1u);
+        if (!block) {
+            return PLY_FAILED_ALLOC_ERROR;
+        }
+        columns = block + (alignColumnOffset((U64)(uintptr_t)block) - (U64)(uintptr_t)block);
+    }
+
+    /* now that the block has its final location, the column offsets can become pointers */
+    for (ei = 0; ei < scene->elementCount; ++ei)
+    {
+        struct PlyElement* element = scene->elements + ei;
+        if (programs[ei].skip) {
+            continue;
+        }
+        U32 pi = 0u;
+        for (; pi < element->propertyCount; ++pi) {
+            struct PlyProperty* property = element->properties + pi;
+            property->columnData = columns + (U64)(uintptr_t)property->columnData;
+            /* listOffsets still holds an offset here, which is 0 for a list column at the start of the block */
+            if (property->dataType == PLY_DATA_TYPE_LIST) {
+                property->listOffsets = (U64*)(columns + (U64)(uintptr_t)property->listOffsets);
+                property->listOffsets[element->dataLineCount] = 0u;
+            }
+        }
+    }
+
+    /* several jobs per thread so that elements of different sizes still balance out, elements with lists are one job each */
+    if (threadCount > PLY_MAX_THREADS) {
+        threadCount = PLY_MAX_THREADS;
+    }
+    if (totalSize / PLY_MIN_PARALLEL_FILL_SIZE < threadCount) {
+        threadCount = (U32)(totalSize / PLY_MIN_PARALLEL_FILL_SIZE);
+    }
+    if (threadCount < 1u) {
+        threadCount = 1u;
+    }
+    const U64 targetJobSize = max(totalSize / ((U64)threadCount * 4u), PLY_MIN_PARALLEL_FILL_SIZE);
+
+    struct PlyColumnJob* jobs = NULL;
+    if (maxJobCount != 0u) {
+        jobs = (struct PlyColumnJob*)plyRealloc(NULL, sizeof(struct PlyColumnJob) * maxJobCount);
+        if (!jobs) {
+            plyDealloc(block);
+            return PLY_FAILED_ALLOC_ERROR;
+        }
+    }
+
+    U32 jobCount = 0u;
+    for (ei = 0; ei < scene->elementCount; ++ei)
+    {
+        struct PlyElement* element = scene->elements + ei;
+        const U64 lineCount = element->dataLineCount;
+        if (programs[ei].skip || lineCount == 0u || element->dataSize == 0u) {
+            continue;
+        }
+        U64 linesPerJob = lineCount;
+        if (getColumnSourceStride(programs + ei, fromFile) != 0u) {
+            const U64 elementJobCount = element->dataSize / targetJobSize + 1u;
+            linesPerJob = (lineCount + elementJobCount - 1u) / elementJobCount;
+        }
+
+        U64 firstLine = 0u;
+        while (firstLine < lineCount) {
+            struct PlyColumnJob* job = jobs + jobCount++;
+            job->element = element;
+            job->program = programs + ei;
+            job->firstLine = firstLine;
+            job->lineCount = min(linesPerJob, lineCount - firstLine);
+            firstLine += job->lineCount;
+        }
+    }
+
+    struct PlyColumnContext fill;
+    fill.jobs = jobs;
+    fill.jobCount = jobCount;
+    fill.workerCount = min(threadCount, jobCount);
+    fill.swap = swap;
+    fill.rowsIncludeDropped = fromFile;
+    if (jobCount != 0u) {
+        runParallel(columnWorker, &fill, fill.workerCount);
+    }
+    plyDealloc(jobs);
+
+    /* the values only live in the columns now */
+    for (ei = 0; ei < scene->elementCount; ++ei)
+    {
+        struct PlyElement* element = scene->elements + ei;
+        element->data = NULL;
+        element->dataSize = 0u;
+        element->dataLineStride = 0u;
+        sceneDealloc(scene, element->dataLineBegins);
+        element->dataLineBegins = NULL;
+        U32 pi = 0u;
+        for (; pi < element->propertyCount; ++pi) {
+            struct PlyProperty* property = element->properties + pi;
+            sceneDealloc(scene, property->dataLineOffsets);
+            property->dataLineOffsets = NULL;
+            property->dataLineOffset = 0u;
+            property->listArity = 0u;
+            property->denseList = false;
+        }
+    }
+
+    *blockOut = block;
+    return PLY_SUCCESS;
+}
+
+/* reads the binary data section straight into the columns of PlyLoadInfo::columnarData */
+static enum PlyResult readDataBinaryColumns(struct PlyScene* scene, struct PlyRowProgram* programs, const U8* dataBegin, const U8* dataLast, const struct PlyLoadInfo* loadInfo)
+{
+    if (dataBegin > dataLast + 1) {
+        return PLY_GENERIC_ERROR;
+    }
+
+    /* the strides let excluded elements be skipped in O(1) */
+    U32 ei = 0;
+    for (; ei < scene->elementCount; ++ei) {
+        enum PlyResult r = setElementLayout(scene->elements + ei);
+        if (r != PLY_SUCCESS)
+            return r;
+    }
+
+    const bool swap = PlyGetSystemEndianness() != scene->format;
+    return buildColumns(scene, programs, dataBegin, dataLast, swap, true, loadInfo->threadCount, &scene->sharedElementData);
+}
+
+
+
+
+
+
+
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define PLY_LITTLE_ENDIAN_HOST 1
+#else
+#define PLY_LITTLE_ENDIAN_HOST 0
+#endif
+
+PLY_INLINE bool isDecimalDigit(const char c)
+{
+    return (U8)(c - '0') < 10u;
+}
+
+/* converts 8 digit values, one per byte with the most significant digit in the lowest byte, in 3 multiply steps */
+PLY_INLINE U64 convertEightDigits(U64 val)
+{
+    val = (val * 10u) + (val >> 8);
+    val = (((val & 0x000000FF000000FFu) * (100u + ((U64)1000000u << 32))) + (((val >> 16) & 0x000000FF000000FFu) * (1u + ((U64)10000u << 32)))) >> 32;
+    return val;
+}
+
+/* parses the run of decimal digits at the beginning of str, reading no more than avail bytes.
+Digits are consumed 8 at a time while 8 bytes are available. Returns the number of digits,
+overflowOut is set if the value does not fit in 64 bits. */
+static U64 parseDecimalDigits(const char* str, const U64 avail, U64* valueOut, bool* overflowOut)
+{
+    static const U64 powersOfTen[] = { 1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u };
+    U64 value = 0u;
+    U64 count = 0u;
+    *overflowOut = false;
+
+#if PLY_LITTLE_ENDIAN_HOST
+    while (avail - count >= 8u)
+    {
+        U64 chunk;
+        memcpy(&chunk, str + count, sizeof(chunk));
+        /* digits become the values 0 to 9, every other byte becomes 10 or more */
+        const U64 v = chunk ^ 0x3030303030303030u;
+        const U64 nonDigits = (((v & 0x7F7F7F7F7F7F7F7Fu) + 0x7676767676767676u) | v) & 0x8080808080808080u;
+        const U32 n = nonDigits ? plyCtz64(nonDigits) >> 3 : 8u;
+        if (n == 0u || count + n > 19u) {
+            break; /* the scalar loop finishes the number and checks it for overflow */
+        }
+        /* move the digits to the top so that the missing leading digits are zeros */
+        value = value * powersOfTen[n] + convertEightDigits(v << (8u * (8u - n)));
+        count += n;
+        if (n < 8u) {
+            *valueOut = value;
+            return count;
+        }
+    }
+#endif
+
+    for (; count < avail && isDecimalDigit(str[count]); ++count) {
+        const U64 digit = (U64)(str[count] - '0');
+        /* 19 digits always fit */
+        if (count >= 19u && value > (UINT64_MAX - digit) / 10u) {
+            *overflowOut = true;
+        }
+        value = value * 10u + digit;
+    }
+    *valueOut = value;
+    return count;
+}
+
+/* parses an unsigned integer of at most max, returns its length or 0 if it is not a number or is out of range */
+static U8 parseUnsignedBounded(const char* str, const U64 avail, const U64 max, U64* valueOut)
+{
+    bool overflow;
+    const U64 len = parseDecimalDigits(str, avail, valueOut, &overflow);
+    if (len == 0u || len > UINT8_MAX || overflow || *valueOut > max) {
+        *valueOut = 0u;
+        return 0u;
+    }
+    return (U8)len;
+}
+
+/* parses a signed integer in [-max-1, max], returns its length including the sign or 0 if it is not a number or is out of range */
+static U8 parseSignedBounded(const char* str, const U64 avail, const U64 max, I64* valueOut)
+{
+    *valueOut = 0;
+    if (avail == 0u) {
+        return 0u;
+    }
+    const bool negative = *str == '-';
+    const U64 signLen = negative ? 1u : 0u;
+
+    U64 magnitude;
+    bool overflow;
+    const U64 len = signLen + parseDecimalDigits(str + signLen, avail - signLen, &magnitude, &overflow);
+    if (len == signLen || len > UINT8_MAX || overflow || magnitude > max + signLen) {
+        return 0u;
+    }
+    *valueOut = negative ? -(I64)(magnitude - 1u) - 1 : (I64)magnitude;
+    return (U8)len;
+}
+
+/* length of the leading [-]digits run of a null terminated string, which bounds the integer parsers */
+PLY_INLINE U64 integerRunLength(const char* str)
+{
+    U64 len = *str == '-' ? 1u : 0u;
+    while (len < UINT8_MAX && isDecimalDigit(str[len])) {
+        ++len;
+    }
+    return len;
+}
+
+/* ASCII decoders for every scalar type, they read no more than avail bytes of str except for floats, which stop at the first non number character */
+static U8 decodeAsciiChar(const char* str, const U64 avail, U8* dst)
+{
+    I64 i;
+    const U8 len = parseSignedBounded(str, avail, INT8_MAX, &i);
+    const I8 v = (I8)i;
+    memcpy(dst, &v, sizeof(v));
+    return len;
+}
+
+static U8 decodeAsciiUChar(const char* str, const U64 avail, U8* dst)
+{
+    U64 u;
+    const U8 len = parseUnsignedBounded(str, avail, UINT8_MAX, &u);
+    *dst = (U8)u;
+    return len;
+}
 
-            const U64 elementNameLen = (elementNameLast - elementNameBegin) + 1u;
+static U8 decodeAsciiShort(const char* str, const U64 avail, U8* dst)
+{
+    I64 i;
+    const U8 len = parseSignedBounded(str, avail, INT16_MAX, &i);
+    const I16 v = (I16)i;
+    memcpy(dst, &v, sizeof(v));
+    return len;
+}
 
-            if (elementNameLen > PLY_MAX_ELEMENT_AND_PROPERTY_NAME_LENGTH) {
-                return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-            }
+static U8 decodeAsciiUShort(const char* str, const U64 avail, U8* dst)
+{
+    U64 u;
+    const U8 len = parseUnsignedBounded(str, avail, UINT16_MAX, &u);
+    const U16 v = (U16)u;
+    memcpy(dst, &v, sizeof(v));
+    return len;
+}
 
+static U8 decodeAsciiInt(const char* str, const U64 avail, U8* dst)
+{
+    I64 i;
+    const U8 len = parseSignedBounded(str, avail, INT32_MAX, &i);
+    const I32 v = (I32)i;
+    memcpy(dst, &v, sizeof(v));
+    return len;
+}
 
+static U8 decodeAsciiUInt(const char* str, const U64 avail, U8* dst)
+{
+    U64 u;
+    const U8 len = parseUnsignedBounded(str, avail, UINT32_MAX, &u);
+    const U32 v = (U32)u;
+    memcpy(dst, &v, sizeof(v));
+    return len;
+}
 
+/* defined with the float parser at the end of the file */
+static float parseFloatBounded(const char* str, const U64 avail, U8* strLenOut);
+static double parseDoubleBounded(const char* str, const U64 avail, U8* strLenOut);
 
-            /*find propertyCountBegin*/
-            const char* dataCountBegin = NULL;
+static U8 decodeAsciiFloat(const char* str, const U64 avail, U8* dst)
+{
+    U8 len;
+    const float v = parseFloatBounded(str, avail, &len);
+    memcpy(dst, &v, sizeof(v));
+    return len;
+}
 
-            /*find element name last*/
-            ch = elementNameLast + 1;
-            for (; ch <= lineLast; ++ch)
-            {
-                if (isspace(*ch)) {
-                    continue;
-                }
-                if (*ch < '0' || *ch > '9') {
-                    return PLY_MALFORMED_HEADER_ERROR;
-                }
-                else {
-                    dataCountBegin = ch;
-                    break;
-                }
-            }
+static U8 decodeAsciiDouble(const char* str, const U64 avail, U8* dst)
+{
+    U8 len;
+    const double v = parseDoubleBounded(str, avail, &len);
+    memcpy(dst, &v, sizeof(v));
+    return len;
+}
 
-            if (dataCountBegin == NULL) {
-                return PLY_MALFORMED_HEADER_ERROR;
-            }
+static U8 decodeAsciiUndefined(const char* str, const U64 avail, U8* dst)
+{
+    (void)str; (void)avail; (void)dst;
+    return 0u;
+}
+
+PLY_INLINE PlyAsciiDecodeFn getAsciiDecodeFn(const enum PlyScalarType type)
+{
+    switch (type)
+    {
+    case PLY_SCALAR_TYPE_CHAR: return decodeAsciiChar;
+    case PLY_SCALAR_TYPE_UCHAR: return decodeAsciiUChar;
+    case PLY_SCALAR_TYPE_SHORT: return decodeAsciiShort;
+    case PLY_SCALAR_TYPE_USHORT: return decodeAsciiUShort;
+    case PLY_SCALAR_TYPE_INT: return decodeAsciiInt;
+    case PLY_SCALAR_TYPE_UINT: return decodeAsciiUInt;
+    case PLY_SCALAR_TYPE_FLOAT: return decodeAsciiFloat;
+    case PLY_SCALAR_TYPE_DOUBLE: return decodeAsciiDouble;
+    default: return decodeAsciiUndefined;
+    }
+}
 
-            const U32 dataCount = strtoul(dataCountBegin, NULL, 0u);
+/* adds the ASCII decoders to row programs made by compileRowPrograms */
+static void compileAsciiDecoders(const struct PlyScene* scene, struct PlyRowProgram* programs)
+{
+    U32 ei = 0;
+    for (; ei < scene->elementCount; ++ei)
+    {
+        const struct PlyElement* element = scene->elements + ei;
+        U32 pi = 0u;
+        for (; pi < element->propertyCount; ++pi) {
+            const struct PlyProperty* property = element->properties + pi;
+            struct PlyRowStep* step = programs[ei].steps + pi;
+            step->decodeValue = getAsciiDecodeFn(property->scalarType);
+            step->decodeCount = step->readCount ? getAsciiDecodeFn(property->listCountType) : NULL;
+        }
+    }
+}
 
+#define PLY_NO_TOKEN UINT64_MAX
 
+/* whitespace as defined by isspace() in the C locale, plus the null terminator */
+PLY_INLINE bool isAsciiSpace(const U8 c)
+{
+    return c == ' ' || c == '\0' || (U8)(c - '\t') <= (U8)('\r' - '\t');
+}
 
-            struct PlyElement element = { 0 };
-            
-            if (loadInfo && loadInfo->elementCount != PLY_LOAD_ALL_ELEMENTS) {
-                bool told = false;
-                U64 i = 0;
-                for (; i < loadInfo->elementCount; ++i) {
-                    if (strneql(elementNameBegin,loadInfo->elements[i],elementNameLast-elementNameBegin+1)) {
-                        told = true;
-                        break;
-                    }
-                }
-                if (!told)
-                    return PLY_SUCCESS;
-            }
+/* sets a bit in spaceOut for every whitespace byte and a bit in newlineOut for every '\n' of a 64 byte block */
+PLY_INLINE void classifyAsciiBlock(const U8* block, U64* spaceOut, U64* newlineOut)
+{
+    U64 space = 0u;
+    U64 newline = 0u;
+#if PLY_USE_AVX2
+    const __m256i spaceChar = _mm256_set1_epi8(' ');
+    const __m256i newlineChar = _mm256_set1_epi8('\n');
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i ctrlRange = _mm256_set1_epi8('\r' - '\t');
+    U32 i = 0u;
+    for (; i < 64u; i += 32u) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(block + i));
+        const __m256i ctrl = _mm256_sub_epi8(v, tab);
+        /* '\t' to '\r' are the bytes where v - '\t' is at most 4 as an unsigned value */
+        __m256i isSpace = _mm256_cmpeq_epi8(_mm256_min_epu8(ctrl, ctrlRange), ctrl);
+        isSpace = _mm256_or_si256(isSpace, _mm256_cmpeq_epi8(v, spaceChar));
+        isSpace = _mm256_or_si256(isSpace, _mm256_cmpeq_epi8(v, zero));
+        space |= (U64)(U32)_mm256_movemask_epi8(isSpace) << i;
+        newline |= (U64)(U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newlineChar)) << i;
+    }
+#elif PLY_USE_SSE2
+    const __m128i spaceChar = _mm_set1_epi8(' ');
+    const __m128i newlineChar = _mm_set1_epi8('\n');
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i ctrlRange = _mm_set1_epi8('\r' - '\t');
+    U32 i = 0u;
+    for (; i < 64u; i += 16u) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(block + i));
+        const __m128i ctrl = _mm_sub_epi8(v, tab);
+        /* '\t' to '\r' are the bytes where v - '\t' is at most 4 as an unsigned value */
+        __m128i isSpace = _mm_cmpeq_epi8(_mm_min_epu8(ctrl, ctrlRange), ctrl);
+        isSpace = _mm_or_si128(isSpace, _mm_cmpeq_epi8(v, spaceChar));
+        isSpace = _mm_or_si128(isSpace, _mm_cmpeq_epi8(v, zero));
+        space |= (U64)(U32)_mm_movemask_epi8(isSpace) << i;
+        newline |= (U64)(U32)_mm_movemask_epi8(_mm_cmpeq_epi8(v, newlineChar)) << i;
+    }
+#else
+    U32 i = 0u;
+    for (; i < 64u; ++i) {
+        space |= (U64)isAsciiSpace(block[i]) << i;
+        newline |= (U64)(block[i] == '\n') << i;
+    }
+#endif
+    *spaceOut = space;
+    *newlineOut = newline;
+}
 
+/* streams the offsets of the whitespace separated tokens of an ASCII data section.
+The data is classified 64 bytes at a time into bitmasks, token starts are the non space bytes that follow a space byte. */
+struct PlyAsciiTokenizer
+{
+    const U8* data;
+    U64 size;
+    U64 blockOffset; /* offset of the current 64 byte block */
+    U64 starts; /* token starts of the current block that come after the current token */
+    U64 newlines; /* newlines of the current block that come after the current token */
+    U64 spaceCarry; /* 1 if the last byte of the previous block was whitespace */
+    U64 token; /* offset of the current token, or PLY_NO_TOKEN once the data is exhausted */
+    bool tokenStartsLine; /* true if a newline lies between the previous token and the current one */
+};
+
+static void loadAsciiBlock(struct PlyAsciiTokenizer* t)
+{
+    U64 space;
+    U64 newline;
+    const U64 remaining = t->size - t->blockOffset;
+    if (remaining >= 64u) {
+        classifyAsciiBlock(t->data + t->blockOffset, &space, &newline);
+    }
+    else {
+        /* never read past the data, pad the last block with spaces */
+        U8 tail[64];
+        memset(tail, ' ', sizeof(tail));
+        memcpy(tail, t->data + t->blockOffset, remaining);
+        classifyAsciiBlock(tail, &space, &newline);
+    }
+    t->starts = ~space & ((space << 1) | t->spaceCarry);
+    t->spaceCarry = space >> 63;
+    t->newlines = newline;
+}
 
-            memcpy_s(element.name, sizeof(element.name)-1, elementNameBegin, elementNameLen);
-            element.name[elementNameLen] = '\0';
-            element.dataLineCount = dataCount;
+/* moves to the next token */
+static void advanceAsciiToken(struct PlyAsciiTokenizer* t)
+{
+    t->tokenStartsLine = false;
+    while (t->starts == 0u) {
+        if (t->newlines != 0u) {
+            t->tokenStartsLine = true;
+        }
+        t->blockOffset += 64u;
+        if (t->blockOffset >= t->size) {
+            t->token = PLY_NO_TOKEN;
+            return;
+        }
+        loadAsciiBlock(t);
+    }
 
-            if (checkForElementNameCollision(scene, element.name) == true)
-                return PLY_MALFORMED_HEADER_ERROR;
+    const U32 bit = plyCtz64(t->starts);
+    t->starts &= t->starts - 1u;
+    if ((t->newlines & (((U64)1u << bit) - 1u)) != 0u) {
+        t->tokenStartsLine = true;
+    }
+    t->newlines &= ~(((U64)2u << bit) - 1u);
+    t->token = t->blockOffset + bit;
+}
 
-            if (PlySceneAddElement(scene, &element)!=PLY_SUCCESS)
-            {
-                return PLY_FAILED_ALLOC_ERROR;
-            }
+static void initAsciiTokenizer(struct PlyAsciiTokenizer* t, const U8* data, const U64 size)
+{
+    t->data = data;
+    t->size = size;
+    t->blockOffset = 0u;
+    t->starts = 0u;
+    t->newlines = 0u;
+    t->spaceCarry = 1u; /* the data section begins after the newline of end_header */
+    t->token = PLY_NO_TOKEN;
+    t->tokenStartsLine = true;
+    if (size == 0u) {
+        return;
+    }
+    loadAsciiBlock(t);
+    advanceAsciiToken(t);
+    t->tokenStartsLine = true;
+}
 
-            *curElement = &scene->elements[scene->elementCount-1];
+/* moves to the token that begins the data line lineCount lines after the current one, without looking at any value.
+Only the first token after each newline is visited, found from the block masks. Returns false if the data has fewer lines. */
+static bool skipAsciiLines(struct PlyAsciiTokenizer* t, const U64 lineCount)
+{
+    /* anything left over on the previous line is ignored */
+    while (t->token != PLY_NO_TOKEN && !t->tokenStartsLine) {
+        advanceAsciiToken(t);
+    }
+    if (lineCount == 0u) {
+        return true;
+    }
+    if (t->token == PLY_NO_TOKEN) {
+        return false;
+    }
 
-            return PLY_SUCCESS;
-        } /* end get element */
-        
-        if (*curElement != NULL) {
-            c = "property ";
-            /* check for proerty declaration */
-            if (strneql(line, c, min(strlen(c), lineLen)) == true)
-            {
-                enum PlyResult r = parseProperty(*curElement, line+strlen(c), lineLast);
-                return r;
+    U64 lineStarts = 0u; /* tokens passed that begin a line, not counting the current one */
+    bool pendingNewline = false; /* a newline at the end of a previous block has not been followed by a token yet */
+    for (;;)
+    {
+        U64 starts = t->starts;
+        U64 newlines = t->newlines;
+        for (;;)
+        {
+            /* the first token after a newline begins a line, newlines before it only end empty lines */
+            U64 candidates = starts;
+            if (!pendingNewline) {
+                if (newlines == 0u)
+                    break;
+                candidates &= ~(((U64)2u << plyCtz64(newlines)) - 1u);
+            }
+            if (candidates == 0u) {
+                pendingNewline = true;
+                break;
+            }
+            pendingNewline = false;
+
+            const U32 bit = plyCtz64(candidates);
+            const U64 after = ~(((U64)2u << bit) - 1u);
+            starts &= after;
+            newlines &= after;
+            if (++lineStarts == lineCount) {
+                t->starts = starts;
+                t->newlines = newlines;
+                t->token = t->blockOffset + bit;
+                t->tokenStartsLine = true;
+                return true;
             }
         }
-        c = "obj_info";
-        if (strneql(line, c, min(strlen(c), lineLen)) == true)
-        {
-            enum PlyResult r = parseObjectInfo(scene, line + strlen(c), lineLast);
-            return r;
+
+        t->blockOffset += 64u;
+        if (t->blockOffset >= t->size) {
+            /* the skipped lines may be the last ones */
+            t->token = PLY_NO_TOKEN;
+            t->starts = 0u;
+            t->newlines = 0u;
+            return lineStarts + 1u >= lineCount;
         }
+        loadAsciiBlock(t);
+    }
+}
+
+/* decodes the current token into dst and moves to the next token.
+The token must be on the current data line unless it starts the data line. */
+PLY_INLINE enum PlyResult decodeAsciiToken(struct PlyAsciiTokenizer* t, const PlyAsciiDecodeFn decode, const bool startsLine, U8* dst)
+{
+    if (t->token == PLY_NO_TOKEN || (t->tokenStartsLine && !startsLine)) {
+        return PLY_MALFORMED_DATA_ERROR;
     }
 
+    const char* str = (const char*)t->data + t->token;
+    const U8 strLen = decode(str, t->size - t->token, dst);
+    if (strLen == 0u) {
+        return PLY_DATA_TYPE_MISMATCH_ERROR;
+    }
+    /* prevent buffer overrun */
+    if (strLen > t->size - t->token) {
+        return PLY_MALFORMED_DATA_ERROR;
+    }
+    /* the whole token must be the number */
+    if (strLen < t->size - t->token && !isAsciiSpace((U8)str[strLen])) {
+        return PLY_DATA_TYPE_MISMATCH_ERROR;
+    }
 
-    /* there is nothing to read, skip this line. */
+    advanceAsciiToken(t);
     return PLY_SUCCESS;
 }
 
+/* growable buffer that the ASCII loader parses the element data into */
+struct PlyDataBuffer
+{
+    U8* data;
+    U64 size;
+    U64 capacity;
+};
 
-PLY_INLINE enum PlyResult allocateDataLinesForElement(struct PlyElement* element)
+/* makes room for at least extra more bytes, at least doubling the capacity when it grows */
+static enum PlyResult reserveDataBuffer(struct PlyDataBuffer* buffer, const U64 extra)
 {
+    if (buffer->size + extra < buffer->size) {
+        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+    }
+    if (buffer->size + extra <= buffer->capacity) {
+        return PLY_SUCCESS;
+    }
 
-    element->dataLineBegins = plyReCalloc(element->dataLineBegins, 0, element->dataLineCount, sizeof(U64));
-    if (!element->dataLineBegins) {
+    U64 capacity = buffer->capacity * 2u;
+    if (capacity < buffer->size + extra) {
+        capacity = buffer->size + extra;
+    }
+    U8* data = (U8*)plyRealloc(buffer->data, capacity);
+    if (!data) {
         return PLY_FAILED_ALLOC_ERROR;
     }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return PLY_SUCCESS;
+}
 
-    /* create data line offsets for the properties of this element*/
-    U64 pi = 0u;
-    for (; pi < element->propertyCount; ++pi) {
-        struct PlyProperty* property = element->properties + pi;
-        property->dataLineOffsets = plyReCalloc(NULL, 0, element->dataLineCount, sizeof(U32));
-        if (!property->dataLineOffsets) {
-            return PLY_FAILED_ALLOC_ERROR;
-        }
+/* parses the current token and appends it to the buffer */
+PLY_INLINE enum PlyResult appendAsciiValue(struct PlyAsciiTokenizer* t, struct PlyDataBuffer* buffer, const PlyAsciiDecodeFn decode, const U8 size, const bool startsLine)
+{
+    if (buffer->size + size > buffer->capacity) {
+        enum PlyResult r = reserveDataBuffer(buffer, size);
+        if (r != PLY_SUCCESS)
+            return r;
     }
+    enum PlyResult r = decodeAsciiToken(t, decode, startsLine, buffer->data + buffer->size);
+    if (r != PLY_SUCCESS)
+        return r;
+    buffer->size += size;
     return PLY_SUCCESS;
 }
 
+/* PLY_ROW_KERNEL_FLOATS_AND_BYTES, the whole row is reserved at once and every decoder is known at compile time */
+PLY_INLINE enum PlyResult readAsciiFloatsAndBytes(struct PlyAsciiTokenizer* t, const struct PlyRowProgram* program, struct PlyDataBuffer* buffer)
+{
+    const U64 lineSize = (U64)program->kernelFloatCount * sizeof(float) + program->kernelByteCount;
+    if (buffer->size + lineSize > buffer->capacity) {
+        enum PlyResult r = reserveDataBuffer(buffer, lineSize);
+        if (r != PLY_SUCCESS)
+            return r;
+    }
 
+    U8* dst = buffer->data + buffer->size;
+    U32 i = 0u;
+    for (; i < program->kernelFloatCount; ++i, dst += sizeof(float)) {
+        enum PlyResult r = decodeAsciiToken(t, decodeAsciiFloat, i == 0u, dst);
+        if (r != PLY_SUCCESS)
+            return r;
+    }
+    for (i = 0; i < program->kernelByteCount; ++i, ++dst) {
+        enum PlyResult r = decodeAsciiToken(t, decodeAsciiUChar, false, dst);
+        if (r != PLY_SUCCESS)
+            return r;
+    }
+    buffer->size += lineSize;
+    return PLY_SUCCESS;
+}
 
-static enum PlyResult readDataBinary(struct PlyScene* scene, const U8* dataBegin, const U8* dataLast)
+/* decodes the values of a list into dst */
+PLY_INLINE enum PlyResult decodeAsciiListValues(struct PlyAsciiTokenizer* t, const PlyAsciiDecodeFn decode, const U8 scalarSize, const U64 listCount, U8* dst)
 {
-    if (dataBegin > dataLast) {
-        return PLY_GENERIC_ERROR;
+    U64 li = 0u;
+    for (; li < listCount; ++li, dst += scalarSize) {
+        enum PlyResult r = decodeAsciiToken(t, decode, false, dst);
+        if (r == PLY_MALFORMED_DATA_ERROR) {
+            /* mismatch between actual list count and expected list count */
+            return PLY_LIST_COUNT_MISMATCH_ERROR;
+        }
+        if (r != PLY_SUCCESS)
+            return r;
     }
-    if (scene->elementCount == 0)
-        return PLY_SUCCESS;
+    return PLY_SUCCESS;
+}
 
-    const U64 dataSize = (dataLast - dataBegin) + 1;
+/* PLY_ROW_KERNEL_BYTE_COUNTED_INTS */
+PLY_INLINE enum PlyResult readAsciiByteCountedInts(struct PlyAsciiTokenizer* t, const struct PlyRowProgram* program, struct PlyDataBuffer* buffer)
+{
+    /* room for the count and a triangle or a quad, longer lists reserve the rest */
+    if (buffer->size + 1u + 4u * sizeof(U32) > buffer->capacity) {
+        enum PlyResult r = reserveDataBuffer(buffer, 1u + 4u * sizeof(U32));
+        if (r != PLY_SUCCESS)
+            return r;
+    }
+    enum PlyResult r = decodeAsciiToken(t, decodeAsciiUChar, true, buffer->data + buffer->size);
+    if (r != PLY_SUCCESS)
+        return r;
+    const U8 listCount = buffer->data[buffer->size];
+    if (listCount > 4u) {
+        r = reserveDataBuffer(buffer, 1u + (U64)listCount * sizeof(U32));
+        if (r != PLY_SUCCESS)
+            return r;
+    }
 
-    enum PlyFormat systemEndianness = PlyGetSystemEndianness();
+    U8* dst = buffer->data + buffer->size + 1u;
+    if (program->kernelSigned) {
+        r = decodeAsciiListValues(t, decodeAsciiInt, sizeof(I32), listCount, dst);
+    }
+    else {
+        r = decodeAsciiListValues(t, decodeAsciiUInt, sizeof(U32), listCount, dst);
+    }
+    if (r != PLY_SUCCESS)
+        return r;
+    buffer->size += 1u + (U64)listCount * sizeof(U32);
+    return PLY_SUCCESS;
+}
 
-    U64 ei = 0;
-    const U8* dataPrev = dataBegin;
+/* passes over the count tokens of a property that PlyLoadInfo::propertySelections left out, without converting them.
+The first token must start the data line if startsLine is true, the others must be on the same line. */
+static enum PlyResult skipAsciiValues(struct PlyAsciiTokenizer* t, const U64 count, const bool startsLine)
+{
+    U64 i = 0u;
+    for (; i < count; ++i) {
+        if (t->token == PLY_NO_TOKEN || (t->tokenStartsLine && !(startsLine && i == 0u))) {
+            return PLY_MALFORMED_DATA_ERROR;
+        }
+        advanceAsciiToken(t);
+    }
+    return PLY_SUCCESS;
+}
 
-       
-    U64 totalAllocSize = 0u;
+/* decodes one data line of an element with a PlyElementBinding from the token stream straight into the caller's buffer */
+static enum PlyResult readAsciiBoundLine(struct PlyAsciiTokenizer* t, const struct PlyRowProgram* program, const U64 dli)
+{
+    /* anything left over on the previous line is ignored */
+    while (t->token != PLY_NO_TOKEN && !t->tokenStartsLine) {
+        advanceAsciiToken(t);
+    }
+    if (t->token == PLY_NO_TOKEN) {
+        return PLY_MALFORMED_DATA_ERROR;
+    }
 
-    /* precompute the total amount of data that will be needed for each element */
-    for (; ei < scene->elementCount; ++ei)
+    U32 pi = 0u;
+    for (; pi < program->stepCount; ++pi)
     {
-        struct PlyElement* element = scene->elements + ei;
-        if (element->dataLineCount == 0) {
-            continue; /* empty element (idk if this is permitted by the standard or not) */
+        const struct PlyRowStep* step = program->steps + pi;
+        enum PlyResult r;
+        if (step->readCount) {
+            U8 count[8];
+            r = decodeAsciiToken(t, step->decodeCount, pi == 0u, count);
+            if (r != PLY_SUCCESS)
+                return r;
+            r = skipAsciiValues(t, step->readCount(count), false);
+            if (r == PLY_MALFORMED_DATA_ERROR) {
+                return PLY_LIST_COUNT_MISMATCH_ERROR;
+            }
+        }
+        else if (step->binding) {
+            U8 value[8];
+            r = decodeAsciiToken(t, step->decodeValue, pi == 0u, value);
+            if (r == PLY_SUCCESS) {
+                writeBoundValue(program, step, dli, value);
+            }
+        }
+        else {
+            r = skipAsciiValues(t, 1u, pi == 0u);
         }
+        if (r != PLY_SUCCESS)
+            return r;
+    }
+    return PLY_SUCCESS;
+}
 
-        element->dataSize = 0u;
-        dataBegin = dataPrev; /* reset on every new elemene that is being read to prevent incorrect offset of dataLineBegins */
-   
+/* reads one data line of an element from the token stream and appends it to the buffer */
+static enum PlyResult readAsciiDataLine(struct PlyAsciiTokenizer* t, struct PlyElement* element, const struct PlyRowProgram* program, const U64 dli, struct PlyDataBuffer* buffer)
+{
+    /* anything left over on the previous line is ignored */
+    while (t->token != PLY_NO_TOKEN && !t->tokenStartsLine) {
+        advanceAsciiToken(t);
+    }
+    if (t->token == PLY_NO_TOKEN) {
+        return PLY_MALFORMED_DATA_ERROR;
+    }
 
-        /* create data lines for element and all its properties*/
-        if (allocateDataLinesForElement(element) != PLY_SUCCESS)
-            return PLY_FAILED_ALLOC_ERROR;
+    U32 pi = 0u;
+    if (program->kernel == PLY_ROW_KERNEL_FLOATS_AND_BYTES) {
+        /* scalar only, so the property offsets are fixed */
+        for (; pi < element->propertyCount; ++pi) {
+            struct PlyProperty* property = element->properties + pi;
+            if (property->dataLineOffsets) {
+                property->dataLineOffsets[dli] = property->dataLineOffset;
+            }
+        }
+        return readAsciiFloatsAndBytes(t, program, buffer);
+    }
+    if (program->kernel == PLY_ROW_KERNEL_BYTE_COUNTED_INTS) {
+        if (element->properties[0].dataLineOffsets) {
+            element->properties[0].dataLineOffsets[dli] = 0u;
+        }
+        return readAsciiByteCountedInts(t, program, buffer);
+    }
 
-        U64 dli = 0;
-        for (; dli < element->dataLineCount; ++dli)
+    const U64 lineBegin = buffer->size;
+    for (; pi < program->stepCount; ++pi)
+    {
+        const struct PlyRowStep* step = program->steps + pi;
+        if (step->drop)
         {
-
-
-            if (dataPrev >= dataLast) {
-                return PLY_MALFORMED_DATA_ERROR;
+            U64 valueCount = 1u;
+            if (step->readCount) {
+                /* the count is still needed to know how many values to pass over */
+                U8 count[8];
+                enum PlyResult r = decodeAsciiToken(t, step->decodeCount, pi == 0u, count);
+                if (r != PLY_SUCCESS)
+                    return r;
+                valueCount = step->readCount(count);
             }
+            enum PlyResult r = skipAsciiValues(t, valueCount, pi == 0u && !step->readCount);
+            if (r == PLY_MALFORMED_DATA_ERROR && step->readCount) {
+                /* mismatch between actual list count and expected list count */
+                return PLY_LIST_COUNT_MISMATCH_ERROR;
+            }
+            if (r != PLY_SUCCESS)
+                return r;
+            continue;
+        }
 
+        const enum PlyResult r = setDataLineOffset(element->properties[step->propertyIdx].dataLineOffsets, dli, buffer->size - lineBegin);
+        if (r != PLY_SUCCESS)
+            return r;
 
-            element->dataLineBegins[dli] = dataPrev - dataBegin;
-
-            U64 pi;
-            for (pi = 0; pi < element->propertyCount; ++pi)
-            {
-
-                struct PlyProperty* property = element->properties + pi;
-
-                if (property->dataType == PLY_DATA_TYPE_SCALAR)
-                {
-                    const U8 scalarSize = PlyGetSizeofScalarType(property->scalarType);
-                    const U64 newSize = element->dataSize + scalarSize;
-
-                    /* prevent overflow */
-                    if (newSize < element->dataSize) {
-                        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-                    }
-
-                    /*advance data pointer by sizeof(property.scalarType)*/
-                    dataPrev += scalarSize;
-
-                    /* prevent buffer overrun */
-                    if (dataPrev > dataLast) {
-                        return PLY_MALFORMED_DATA_ERROR;
-                    }
+        if (!step->readCount)
+        {
+            enum PlyResult r = appendAsciiValue(t, buffer, step->decodeValue, step->scalarSize, pi == 0u);
+            if (r != PLY_SUCCESS)
+                return r;
+        }
+        else
+        {
+            /* get list data count */
+            enum PlyResult r = appendAsciiValue(t, buffer, step->decodeCount, step->listCountSize, pi == 0u);
+            if (r != PLY_SUCCESS)
+                return r;
+            const U64 listCount = step->readCount(buffer->data + buffer->size - step->listCountSize);
 
-                    element->dataSize = newSize;
-                }
-                else
-                {
-                    U64 listCount = 0u;
-                    {
-                        /* get list data count */
-                        const U8 listcountTypeSize = PlyGetSizeofScalarType(property->listCountType);
+            /* the list can not hold more values than there are bytes left, which also keeps the reservation from overflowing */
+            if (listCount > t->size) {
+                return PLY_LIST_COUNT_MISMATCH_ERROR;
+            }
+            r = reserveDataBuffer(buffer, listCount * step->scalarSize);
+            if (r != PLY_SUCCESS)
+                return r;
 
-                        const U64 newLen = element->dataSize + listcountTypeSize;
+            r = decodeAsciiListValues(t, step->decodeValue, step->scalarSize, listCount, buffer->data + buffer->size);
+            if (r != PLY_SUCCESS)
+                return r;
+            buffer->size += listCount * step->scalarSize;
+        }
+    }
+    return PLY_SUCCESS;
+}
 
-                        /* prevent overflow */
-                        if (newLen < element->dataSize) {
-                            return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-                        }
+/* gives an element made of a single list property a dataLineStride if all of its lists have the same count,
+and drops the counts if dense is true. elementBegin is the element's data, which was just parsed. */
+static void setAsciiListArity(const struct PlyScene* scene, struct PlyElement* element, U8* elementBegin, const bool dense)
+{
+    struct PlyProperty* property = element->properties;
+    const U8 listCountSize = PlyGetSizeofScalarType(property->listCountType);
+    const U8 scalarSize = PlyGetSizeofScalarType(property->scalarType);
 
-                        /*advance data pointer by sizeof(property.scalarType)*/
-                        dataPrev += listcountTypeSize;
+    const U64 arity = PlyScaleBytesToU64(elementBegin, property->listCountType);
+    const U64 stride = listCountSize + arity * scalarSize;
+    if (stride > UINT32_MAX || element->dataSize != stride * element->dataLineCount) {
+        return;
+    }
+    const U8* count = elementBegin + stride;
+    const U8* countsEnd = elementBegin + element->dataSize;
+    for (; count < countsEnd; count += stride) {
+        if (memcmp(count, elementBegin, listCountSize) != 0) {
+            return;
+        }
+    }
 
-                        /* prevent buffer overrun */
-                        if (dataPrev > dataLast)
-                            return PLY_MALFORMED_DATA_ERROR;
-                        
+    property->listArity = (U32)arity;
+    property->denseList = dense && arity != 0u;
+    property->dataLineOffset = 0u;
+    element->dataLineStride = (U32)stride;
+    if (property->denseList) {
+        /* move every list over its count, the data only ever moves towards the front */
+        const U64 denseStride = arity * scalarSize;
+        U64 dli = 0;
+        for (; dli < element->dataLineCount; ++dli) {
+            memmove(elementBegin + dli * denseStride, elementBegin + dli * stride + listCountSize, denseStride);
+        }
+        element->dataLineStride = (U32)denseStride;
+        element->dataSize = denseStride * element->dataLineCount;
+        if (element->dataLineBegins && property->dataLineOffsets) {
+            for (dli = 0; dli < element->dataLineCount; ++dli) {
+                element->dataLineBegins[dli] = dli * denseStride;
+            }
+        }
+    }
+    if (!property->dataLineOffsets) {
+        /* compact data lines, a fixed stride needs no dataLineBegins */
+        sceneDealloc(scene, element->dataLineBegins);
+        element->dataLineBegins = NULL;
+    }
+}
 
-                        /*copy list count from data into list count var */
-                        listCount = (U64)PlyScaleBytesToU64(dataPrev - listcountTypeSize, listcountTypeSize);
-                        
-                        if (systemEndianness != scene->format)
-                            PlySwapBytes((U8*)&listCount, property->listCountType);
+/* a newline aligned piece of the ASCII data section that one thread parses into its own buffer */
+struct PlyAsciiChunk
+{
+    const U8* begin;
+    U64 size;
+    U64 firstRow; /* index of the chunk's first data line, counting the data lines of all elements */
+    U64 rowCount;
+    struct PlyDataBuffer buffer;
+    U64* elementBegins; /* elementCount + 1 offsets into buffer, element ei spans [elementBegins[ei], elementBegins[ei + 1]) */
+    U64* elementOffsets; /* where the chunk's part of each element goes in the shared element data */
+    enum PlyResult result;
+};
+
+struct PlyAsciiParallelContext
+{
+    struct PlyScene* scene;
+    const struct PlyRowProgram* programs;
+    struct PlyAsciiChunk* chunks;
+    const U64* elementFirstRows; /* elementCount + 1 entries */
+    U64 totalRows;
+};
+
+/* counts the lines of a chunk that hold at least one token */
+static void countAsciiRowsWorker(void* ctx, U32 chunkIdx)
+{
+    struct PlyAsciiParallelContext* par = (struct PlyAsciiParallelContext*)ctx;
+    struct PlyAsciiChunk* chunk = par->chunks + chunkIdx;
+    struct PlyAsciiTokenizer tokenizer;
+    initAsciiTokenizer(&tokenizer, chunk->begin, chunk->size);
 
-                        element->dataSize = newLen;
-                    }
+    U64 rows = 0u;
+    while (tokenizer.token != PLY_NO_TOKEN) {
+        rows += tokenizer.tokenStartsLine ? 1u : 0u;
+        advanceAsciiToken(&tokenizer);
+    }
+    chunk->rowCount = rows;
+}
 
+static void parseAsciiChunkWorker(void* ctx, U32 chunkIdx)
+{
+    struct PlyAsciiParallelContext* par = (struct PlyAsciiParallelContext*)ctx;
+    struct PlyAsciiChunk* chunk = par->chunks + chunkIdx;
+    struct PlyScene* scene = par->scene;
+    struct PlyAsciiTokenizer tokenizer;
+    initAsciiTokenizer(&tokenizer, chunk->begin, chunk->size);
+
+    /* the binary data is usually smaller than its text */
+    chunk->result = reserveDataBuffer(&chunk->buffer, chunk->size / 2u + 64u);
+    if (chunk->result != PLY_SUCCESS)
+        return;
 
-                    const U8 scalarSize = PlyGetSizeofScalarType(property->scalarType);
+    U64 row = chunk->firstRow;
+    const U64 rowEnd = min(chunk->firstRow + chunk->rowCount, par->totalRows);
+    U64 ei = 0u;
+    while (row < rowEnd)
+    {
+        while (row >= par->elementFirstRows[ei + 1]) {
+            ++ei;
+            chunk->elementBegins[ei] = chunk->buffer.size;
+        }
+        if (par->programs[ei].binding) {
+            chunk->result = readAsciiBoundLine(&tokenizer, par->programs + ei, row - par->elementFirstRows[ei]);
+            if (chunk->result != PLY_SUCCESS)
+                return;
+            ++row;
+            continue;
+        }
+        if (par->programs[ei].skip) {
+            const U64 skipEnd = min(rowEnd, par->elementFirstRows[ei + 1]);
+            if (!skipAsciiLines(&tokenizer, skipEnd - row)) {
+                chunk->result = PLY_MALFORMED_DATA_ERROR;
+                return;
+            }
+            row = skipEnd;
+            continue;
+        }
 
-                    const U64 listSize = scalarSize * listCount; /*in bytes*/
+        struct PlyElement* element = scene->elements + ei;
+        const U64 dli = row - par->elementFirstRows[ei];
+        if (element->dataLineBegins) {
+            /* relative to the chunk for now, corrected once the chunks are merged */
+            element->dataLineBegins[dli] = chunk->buffer.size - chunk->elementBegins[ei];
+        }
 
-                    /*prevent overflow*/
-                    if (element->dataSize + listSize < element->dataSize) {
-                        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-                    }
+        chunk->result = readAsciiDataLine(&tokenizer, element, par->programs + ei, dli, &chunk->buffer);
+        if (chunk->result != PLY_SUCCESS)
+            return;
+        ++row;
+    }
+    for (++ei; ei <= scene->elementCount; ++ei) {
+        chunk->elementBegins[ei] = chunk->buffer.size;
+    }
+}
 
-                    element->dataSize = element->dataSize + listSize;
+/* copies the chunk's data lines to their place in the shared element data */
+static void mergeAsciiChunkWorker(void* ctx, U32 chunkIdx)
+{
+    struct PlyAsciiParallelContext* par = (struct PlyAsciiParallelContext*)ctx;
+    struct PlyAsciiChunk* chunk = par->chunks + chunkIdx;
+    struct PlyScene* scene = par->scene;
 
-                    dataPrev += listSize;
-                    if (dataPrev > dataLast) /*prevent out of bounds read*/
-                        return PLY_MALFORMED_FILE_ERROR;
-                }
+    U64 ei = 0u;
+    for (; ei < scene->elementCount; ++ei)
+    {
+        struct PlyElement* element = scene->elements + ei;
+        const U64 size = chunk->elementBegins[ei + 1] - chunk->elementBegins[ei];
+        if (size == 0u) {
+            continue;
+        }
+        memcpy((U8*)scene->sharedElementData + chunk->elementOffsets[ei], chunk->buffer.data + chunk->elementBegins[ei], size);
+
+        if (element->dataLineBegins) {
+            const U64 elementOffset = (U64)((U8*)element->data - (U8*)scene->sharedElementData);
+            const U64 shift = chunk->elementOffsets[ei] - elementOffset;
+            U64 row = max(chunk->firstRow, par->elementFirstRows[ei]);
+            const U64 rowEnd = min(chunk->firstRow + chunk->rowCount, par->elementFirstRows[ei + 1]);
+            for (; row < rowEnd; ++row) {
+                element->dataLineBegins[row - par->elementFirstRows[ei]] += shift;
             }
         }
-        element->data = (void*)totalAllocSize;
-        totalAllocSize += element->dataSize;
     }
+}
 
+/* parses the ASCII data section on several threads. The data is split into newline aligned chunks, every thread counts the
+data lines of its chunk, a prefix sum over the counts tells each chunk which element and data line it starts at,
+then the chunks are parsed into their own buffers and copied into the shared element data in order. */
+static enum PlyResult readDataASCIIParallel(struct PlyScene* scene, const struct PlyRowProgram* programs, const U8* dataBegin, const U64 dataSize, const struct PlyLoadInfo* loadInfo, U32 chunkCount)
+{
+    const bool compact = loadInfo->compactDataLines;
+    const bool dense = loadInfo->denseLists;
+    enum PlyResult r = PLY_SUCCESS;
 
-    if (totalAllocSize == 0) {
-        return PLY_SUCCESS; /*nothing to allocate*/
+    if (chunkCount > PLY_MAX_THREADS) {
+        chunkCount = PLY_MAX_THREADS;
     }
 
-    scene->sharedElementData = plyRealloc(NULL, totalAllocSize);
-    if (!scene->sharedElementData) {
-        return PLY_FAILED_ALLOC_ERROR;
+    U64* elementFirstRows = (U64*)plyReCalloc(NULL, 0, scene->elementCount + 1u, sizeof(U64));
+    struct PlyAsciiChunk* chunks = (struct PlyAsciiChunk*)plyReCalloc(NULL, 0, chunkCount, sizeof(struct PlyAsciiChunk));
+    U64* chunkOffsets = (U64*)plyReCalloc(NULL, 0, (U64)chunkCount * (scene->elementCount + 1u) * 2u, sizeof(U64));
+    if (!elementFirstRows || !chunks || !chunkOffsets) {
+        r = PLY_FAILED_ALLOC_ERROR;
+        goto bail;
     }
 
-    /* now that data has been allocated, the actual buffer offsets still need to be updated */
+    U64 ei;
     for (ei = 0; ei < scene->elementCount; ++ei)
     {
-        scene->elements[ei].data = (U8*)scene->sharedElementData + (U64)(scene->elements[ei].data); /*apply offsets*/
+        struct PlyElement* element = scene->elements + ei;
+        element->dataSize = 0u;
+        elementFirstRows[ei + 1] = elementFirstRows[ei] + element->dataLineCount;
+        r = setElementLayout(element);
+        if (r != PLY_SUCCESS)
+            goto bail;
+        if (element->dataLineCount != 0u && !programs[ei].skip) {
+            r = allocateDataLinesForElement(scene, element, compact);
+            if (r != PLY_SUCCESS)
+                goto bail;
+        }
+    }
+
+    /* split the data section after the newline closest to each even split point */
+    const U8* dataEnd = dataBegin + dataSize;
+    const U8* chunkBegin = dataBegin;
+    U32 ci = 0u;
+    for (; ci < chunkCount; ++ci)
+    {
+        struct PlyAsciiChunk* chunk = chunks + ci;
+        const U8* chunkEnd = dataEnd;
+        if (ci + 1u < chunkCount) {
+            const U8* split = dataBegin + dataSize / chunkCount * (ci + 1u);
+            if (split < chunkBegin) {
+                split = chunkBegin;
+            }
+            const U8* newline = (const U8*)memchr(split, '\n', dataEnd - split);
+            chunkEnd = newline ? newline + 1 : dataEnd;
+        }
+        chunk->begin = chunkBegin;
+        chunk->size = chunkEnd - chunkBegin;
+        chunk->elementBegins = chunkOffsets + (U64)ci * (scene->elementCount + 1u) * 2u;
+        chunk->elementOffsets = chunk->elementBegins + scene->elementCount + 1u;
+        chunk->result = PLY_SUCCESS;
+        chunkBegin = chunkEnd;
+    }
+
+    struct PlyAsciiParallelContext par;
+    par.scene = scene;
+    par.programs = programs;
+    par.chunks = chunks;
+    par.elementFirstRows = elementFirstRows;
+    par.totalRows = elementFirstRows[scene->elementCount];
+
+    runParallel(countAsciiRowsWorker, &par, chunkCount);
+
+    U64 row = 0u;
+    for (ci = 0; ci < chunkCount; ++ci) {
+        chunks[ci].firstRow = row;
+        row += chunks[ci].rowCount;
+    }
+    if (row < par.totalRows) {
+        r = PLY_MALFORMED_DATA_ERROR; /* not enough data lines */
+        goto bail;
     }
 
+    runParallel(parseAsciiChunkWorker, &par, chunkCount);
 
-    /*reset data prev*/
-    dataPrev = dataLast-dataSize+1;
+    /* the first error in file order is the one that is reported */
+    for (ci = 0; ci < chunkCount; ++ci) {
+        if (chunks[ci].result != PLY_SUCCESS) {
+            r = chunks[ci].result;
+            goto bail;
+        }
+    }
 
+    /* lay the elements out one after another, with each element's chunks in order */
+    U64 totalSize = 0u;
     for (ei = 0; ei < scene->elementCount; ++ei)
     {
         struct PlyElement* element = scene->elements + ei;
-        if (element->dataLineCount == 0) {
-            continue; /* empty element (idk if this is permitted by the standard or not) */
+        element->data = (void*)totalSize;
+        for (ci = 0; ci < chunkCount; ++ci) {
+            chunks[ci].elementOffsets[ei] = totalSize;
+            totalSize += chunks[ci].elementBegins[ei + 1] - chunks[ci].elementBegins[ei];
         }
+        element->dataSize = totalSize - (U64)element->data;
+    }
 
-      
-        dataBegin = dataPrev; /* reset on every new element that is being read to prevent incorrect offset of dataLineBegins */
-      
-        U64 dli = 0;
-        for (; dli < element->dataLineCount; ++dli)
-        {
-            const U8* dataLineBegin = dataPrev;
-
-            U64 pi;
-            for (pi = 0; pi < element->propertyCount; ++pi)
-            {
-                struct PlyProperty* property = element->properties + pi;
-                
-                const U8 scalarSize = PlyGetSizeofScalarType(property->scalarType);
-
-                if (property->dataType == PLY_DATA_TYPE_SCALAR)
-                {
-
-
-                    /* set property data line offset */
-                    const U64 datalineOffset = dataPrev - dataLineBegin;
-                    if (datalineOffset > UINT32_MAX)
-                        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-
-                    property->dataLineOffsets[dli] = (U32)datalineOffset;
-                    
-                
-                    const U64 totalOffset = datalineOffset + element->dataLineBegins[dli];
-                    U8* copyTo = (U8*)(element->data) + totalOffset;
-                    memcpy(
-                        copyTo, /*copy into data*/
-                        dataPrev, /*from mem*/
-                        scalarSize
-                    ); 
-
-                    if (systemEndianness != scene->format)
-                        PlySwapBytes(copyTo, property->scalarType);
-
-                    /*advance data pointer by sizeof(property.scalarType)*/
-                    dataPrev += scalarSize;
-
-                }
-                else
-                {
-                    U64 listCount = 0u;
-                    {
-                        /* get list data count */
-                        const U8 listcountTypeSize = PlyGetSizeofScalarType(property->listCountType);
-
-                        /* set property data line offset */
-                        const U64 datalineOffset = dataPrev - dataLineBegin;
-                        if (datalineOffset > UINT32_MAX)
-                            return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-
-                        property->dataLineOffsets[dli] = (U32)datalineOffset;
-
-                        const U64 totalOffset = datalineOffset + element->dataLineBegins[dli];
-                        U8* copyTo = (U8*)(element->data) + totalOffset;
-                        memcpy(
-                            copyTo, /*copy into data*/
-                            dataPrev, /*from mem*/
-                            listcountTypeSize
-                        );
-
-                        /*copy list count from data into list count var */
-                        listCount = (U64)PlyScaleBytesToU64(dataPrev, listcountTypeSize);
-                        if (systemEndianness != scene->format)
-                            PlySwapBytes(copyTo, property->listCountType);
-
-                        /*advance data pointer by sizeof(property.scalarType)*/
-                        dataPrev += listcountTypeSize;
-                    }
-
-                    U64 offsetFromDatalineOffset = dataPrev - dataLineBegin;
-
-                    const U64 listSize = scalarSize * listCount; /*in bytes*/
-                    const U64 totalOffset = offsetFromDatalineOffset + element->dataLineBegins[dli];
-                    U8* copyTo = (U8*)(element->data) + totalOffset;
-                    memcpy(
-                        copyTo, /*copy into data*/
-                        dataPrev, /*from mem */
-                        listSize
-                    );
-
-                    /* correct endianness */
-                    if (systemEndianness != scene->format) {
-                        /*offsetFromDatalineOffset is not actually line offset, just data offset. I'm just reusing stack space.*/
-                        for (offsetFromDatalineOffset = 0; offsetFromDatalineOffset < listCount*scalarSize; offsetFromDatalineOffset +=scalarSize) {
-                            PlySwapBytes(copyTo + offsetFromDatalineOffset, property->scalarType);
+    if (totalSize != 0u)
+    {
+        scene->sharedElementData = plyRealloc(NULL, totalSize);
+        if (!scene->sharedElementData) {
+            r = PLY_FAILED_ALLOC_ERROR;
+            goto bail;
+        }
+        for (ei = 0; ei < scene->elementCount; ++ei) {
+            scene->elements[ei].data = (U8*)scene->sharedElementData + (U64)scene->elements[ei].data; /*apply offsets*/
+        }
 
-                        }
-                    }
+        runParallel(mergeAsciiChunkWorker, &par, chunkCount);
 
-                    /*increment data prev*/
-                    dataPrev += listSize;
+        /* dense lists shrink their element, move the following elements down to close the gap */
+        U8* dst = (U8*)scene->sharedElementData;
+        for (ei = 0; ei < scene->elementCount; ++ei)
+        {
+            struct PlyElement* element = scene->elements + ei;
+            if (element->dataLineCount != 0u && element->dataLineStride == 0u && element->propertyCount == 1u && !programs[ei].skip) {
+                setAsciiListArity(scene, element, (U8*)element->data, dense);
+            }
+            if ((U8*)element->data != dst) {
+                memmove(dst, element->data, element->dataSize);
+                element->data = dst;
+            }
+            dst += element->dataSize;
+        }
+        const U64 usedSize = dst - (U8*)scene->sharedElementData;
+        if (usedSize < totalSize) {
+            U8* oldData = (U8*)scene->sharedElementData;
+            U8* newData = (U8*)plyRealloc(oldData, usedSize);
+            if (newData && newData != oldData) {
+                for (ei = 0; ei < scene->elementCount; ++ei) {
+                    scene->elements[ei].data = newData + ((U8*)scene->elements[ei].data - oldData);
                 }
             }
+            if (newData) {
+                scene->sharedElementData = newData;
+            }
+        }
+    }
+    else {
+        for (ei = 0; ei < scene->elementCount; ++ei) {
+            scene->elements[ei].data = NULL;
         }
     }
 
-    return PLY_SUCCESS;
+bail:
+    if (r != PLY_SUCCESS) {
+        for (ei = 0; ei < scene->elementCount; ++ei) {
+            scene->elements[ei].data = NULL;
+        }
+    }
+    if (chunks) {
+        for (ci = 0; ci < chunkCount; ++ci) {
+            plyDealloc(chunks[ci].buffer.data);
+        }
+    }
+    plyDealloc(chunks);
+    plyDealloc(chunkOffsets);
+    plyDealloc(elementFirstRows);
+    return r;
 }
 
-
-
-
-
-
-
-
-static enum PlyResult readDataASCII(struct PlyScene* scene, const U8* dataBegin, const U8* dataLast)
+/* parses the ASCII data section in a single pass. Scalar only elements have a known size, list elements grow the buffer as needed. */
+static enum PlyResult readDataASCII(struct PlyScene* scene, const struct PlyRowProgram* programs, const U8* dataBegin, const U8* dataLast, const struct PlyLoadInfo* loadInfo)
 {
     if (scene->elementCount == 0)
         return PLY_SUCCESS;
 
-    const U64 dataSize = (dataLast - dataBegin) + 1;
-
-    const char* line = (const char*)dataBegin;
-    U64 lineLen = lineLen_s(line, (const char*)dataBegin, dataSize);
-
-
+    const bool compact = loadInfo && loadInfo->compactDataLines;
+    const bool dense = loadInfo && loadInfo->denseLists;
 
+    const U64 dataSize = (dataLast - dataBegin) + 1;
+    const U32 threadCount = loadInfo ? loadInfo->threadCount : 0u;
+    if (threadCount > 1u && dataSize / PLY_MIN_PARALLEL_FILL_SIZE > 1u) {
+        return readDataASCIIParallel(scene, programs, dataBegin, dataSize, loadInfo, (U32)min((U64)threadCount, dataSize / PLY_MIN_PARALLEL_FILL_SIZE));
+    }
 
-    U64 totalAllocSize = 0u;
+    struct PlyAsciiTokenizer tokenizer;
+    initAsciiTokenizer(&tokenizer, dataBegin, dataSize);
 
+    /* reserve the exact size of scalar only elements, and guess that lists hold 3 values */
+    struct PlyDataBuffer buffer = { NULL, 0u, 0u };
+    U64 estimate = 0u;
     U64 ei;
-    /*precompute the total amount of data that will be needed for each element*/
     for (ei = 0; ei < scene->elementCount; ++ei)
     {
         struct PlyElement* element = scene->elements + ei;
-        if (element->dataLineCount == 0) {
-            continue; /* empty element (idk if this is permitted by the standard or not) */
+        enum PlyResult r = setElementLayout(element);
+        if (r != PLY_SUCCESS)
+            return r;
+        if (programs[ei].skip) {
+            continue;
         }
 
-        /* create data lines for element and all its properties*/
-        if (allocateDataLinesForElement(element) != PLY_SUCCESS)
-            return PLY_FAILED_ALLOC_ERROR;
-
-        element->dataSize = 0u;
-
-        U64 dli = 0;
-        for (; dli < element->dataLineCount; ++dli)
-        {
-            U32 ploffset = 0u;
-            const char* ch = line;
-
-            const U64 lineBegin = element->dataSize;
-            element->dataLineBegins[dli] = lineBegin;
-
-            U32 countedProperties = 0u;
-
+        U64 lineSize = element->dataLineStride;
+        if (lineSize == 0u) {
             U32 pi = 0u;
-            for (; pi < element->propertyCount; ++pi)
-            {
-                struct PlyProperty* property = element->properties + pi;
-                if (property->dataType == PLY_DATA_TYPE_SCALAR)
-                {
-                    for (; ch < line + lineLen; ++ch)
-                    {
-                        if (isspace(*ch) == 0)
-                        {
-                            countedProperties++;
-
-                            U8 scalarStrLen;
-                            PlyStrToScalar(ch, property->scalarType, &scalarStrLen);
-
-                            if (scalarStrLen == 0u) {
-                                return PLY_DATA_TYPE_MISMATCH_ERROR;
-                            }
-                            else {
-                                ch += scalarStrLen;
-                                /* prevent buffer overrun */
-                                if (ch > line + lineLen) {
-                                    return PLY_MALFORMED_DATA_ERROR;
-                                }
-                            }
-
-
-                            const U8 sze = PlyGetSizeofScalarType(element->properties[pi].scalarType);
-
-                            const U64 newLen = element->dataSize + sze;
-                            if (newLen < element->dataSize)
-                            { /* prevent overflow */
-                                return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-                            }
-
-                            property->dataLineOffsets[dli] = ploffset;
-
-                            /* prevent overflow */
-                            if (ploffset > (U32)ploffset + sze) {
-                                return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-                            }
-
-                            ploffset += sze;
-                            element->dataSize = newLen;
-
-
-                            break; /*found the property value, now stop and go to the next.*/
-                        }
-                    }
-                }
-                else
-                {
-                    /* get list data count */
-                    U64 listCount = 0u;
-
-                    for (; ch < line + lineLen; ++ch)
-                    {
-                        if (isspace(*ch) == 0)
-                        {
-                            countedProperties++;
-
-                            U8 listCountStrLen;
-                            union PlyScalarUnion listCountU = PlyStrToScalar(ch, property->listCountType, &listCountStrLen);
-                            if (listCountStrLen == 0u) {
-                                return PLY_DATA_TYPE_MISMATCH_ERROR;
-                            }
-                            else {
-                                ch += listCountStrLen;
-                                /* prevent buffer overrun */
-                                if (ch > line + lineLen) {
-                                    return PLY_MALFORMED_DATA_ERROR;
-                                }
-                            }
-
-                            U8 sze = PlyGetSizeofScalarType(property->listCountType);
-
-                            const U64 newLen = element->dataSize + sze;
-  
-
-                            element->dataSize = newLen;
-                            element->properties[pi].dataLineOffsets[dli] = ploffset;
-
-
-                            listCount = (U64)PlyScaleBytesToD64(&listCountU, property->listCountType);
-
-
-                            /* prevent overflow */
-                            if (ploffset > (U32)(ploffset + sze + PlyGetSizeofScalarType(property->scalarType) * listCount)) {
-                                return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
-                            }
-                            ploffset += (U32)(sze + PlyGetSizeofScalarType(property->scalarType) * listCount);
-
-                            break; /* found the list size */
-                        }
-                    }
-
-
-                    U64 readPropCount = 0u;
-                    /* get list items */
-                    for (; ch < line + lineLen; ++ch)
-                    {
-                        if (isspace(*ch) == 0)
-                        {
-                            U8 scalarStrLen;
-                            PlyStrToScalar(ch, property->scalarType, &scalarStrLen);
-
-                            if (scalarStrLen == 0u) {
-                                return PLY_DATA_TYPE_MISMATCH_ERROR;
-                            }
-                            else {
-                                ch += scalarStrLen;
-                                /* prevent buffer overrun */
-                                if (ch > line + lineLen) {
-                                    return PLY_MALFORMED_DATA_ERROR;;
-                                }
-                            }
-
-                            U8 sze = PlyGetSizeofScalarType(property->scalarType);
-
-                            const U64 newLen = element->dataSize + sze;
-
-                            element->dataSize = newLen;
-
-                            if (readPropCount + 1 == listCount) {
-                                readPropCount++;
-                                break; /* all elements have been read */
-                            }
-                            readPropCount++;
-
-                            /* DO NOT BREAK LOOP, KEEP READING UNTIL LINE END */
-                        }
-                    }
-
-                    if (readPropCount != listCount)
-
-                    { /* mismatch between actual list count and expected list count */
-                        return PLY_LIST_COUNT_MISMATCH_ERROR;
-                    }
+            for (; pi < element->propertyCount; ++pi) {
+                const struct PlyProperty* property = element->properties + pi;
+                lineSize += PlyGetSizeofScalarType(property->scalarType) * (property->dataType == PLY_DATA_TYPE_LIST ? 3u : 1u);
+                if (property->dataType == PLY_DATA_TYPE_LIST) {
+                    lineSize += PlyGetSizeofScalarType(property->listCountType);
                 }
             }
-            ploffset = 0u;
-
-            if (countedProperties != element->propertyCount) {
-                return PLY_MALFORMED_DATA_ERROR;
-            }
-
-            line = getNextLine(&lineLen, dataBegin, dataSize, line, lineLen);
-            if (dli != element->dataLineCount - 1 && !line) {
-                return PLY_MALFORMED_DATA_ERROR;
-            }
         }
-
-        element->data = (void*)totalAllocSize;
-        totalAllocSize += element->dataSize;
-    }
-
-
-    if (totalAllocSize == 0) {
-        return PLY_SUCCESS; /*nothing to allocate*/
-    }
-
-    scene->sharedElementData = plyRealloc(NULL, totalAllocSize);
-    if (!scene->sharedElementData) {
-        return PLY_FAILED_ALLOC_ERROR;
-    }
-
-    scene->sharedElementData = plyRealloc(NULL, totalAllocSize);
-    /* now that data has been allocated, the actual buffer offsets still need to be updated */
-    for (ei = 0; ei < scene->elementCount; ++ei) {
-        scene->elements[ei].data = (U8*)scene->sharedElementData + (U64)(scene->elements[ei].data); /*apply offsets*/
+        if (lineSize != 0u && element->dataLineCount > (UINT64_MAX - estimate) / lineSize) {
+            return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+        }
+        estimate += lineSize * element->dataLineCount;
     }
 
+    enum PlyResult r = reserveDataBuffer(&buffer, estimate);
+    if (r != PLY_SUCCESS)
+        return r;
 
-
-
-    line = (const char*)dataBegin;
-    lineLen = lineLen_s(line, (const char*)dataBegin, dataSize);
-
-
-    for (ei=0; ei < scene->elementCount; ++ei)
+    for (ei = 0; ei < scene->elementCount; ++ei)
     {
         struct PlyElement* element = scene->elements + ei;
+        const U64 elementBegin = buffer.size;
+        element->data = (void*)elementBegin;
+        element->dataSize = 0u;
         if (element->dataLineCount == 0) {
             continue; /* empty element (idk if this is permitted by the standard or not) */
         }
 
-        U64 curDataOffset = 0u;
+        if (programs[ei].binding) {
+            /* decoded straight into the caller's buffer, nothing is stored in the scene */
+            U64 dli = 0;
+            for (; dli < element->dataLineCount; ++dli) {
+                r = readAsciiBoundLine(&tokenizer, programs + ei, dli);
+                if (r != PLY_SUCCESS)
+                    goto bail;
+            }
+            continue;
+        }
+        if (programs[ei].skip) {
+            /* excluded by PlyLoadInfo::elements, only its lines are counted */
+            if (!skipAsciiLines(&tokenizer, element->dataLineCount)) {
+                r = PLY_MALFORMED_DATA_ERROR;
+                goto bail;
+            }
+            continue;
+        }
+
+        /* create data lines for element and all its properties*/
+        r = allocateDataLinesForElement(scene, element, compact);
+        if (r != PLY_SUCCESS)
+            goto bail;
 
         U64 dli = 0;
         for (; dli < element->dataLineCount; ++dli)
         {
-            U32 ploffset = 0u;
-            const char* ch = line;
-
-            U32 countedProperties = 0u;
-
-            U32 pi = 0u;
-            for (; pi < element->propertyCount; ++pi)
-            {
-                struct PlyProperty* property = element->properties + pi;
-                if (property->dataType == PLY_DATA_TYPE_SCALAR)
-                {
-                    for (; ch < line + lineLen; ++ch)
-                    {
-                        if (isspace(*ch) == 0)
-                        {
-                            countedProperties++;
-
-                            U8 scalarStrLen;
-                            union PlyScalarUnion dataU = PlyStrToScalar(ch, property->scalarType, &scalarStrLen);
-                            if (scalarStrLen == 0u) {
-                                return PLY_DATA_TYPE_MISMATCH_ERROR;
-                            }
-                            else {
-                                ch += scalarStrLen;
-                            }
-                            
-                            const U8 sze = PlyGetSizeofScalarType(element->properties[pi].scalarType);
-
-
-                            property->dataLineOffsets[dli] = ploffset;
-
- 
-
-                            U8* copyTo = (U8*)element->data + curDataOffset;
-                            PlyScalarUnionCpyIntoLocation(copyTo, &dataU, property->scalarType);
-
-                            ploffset += sze;
-                            curDataOffset += sze;
-
-                            break; /*found the property value, now stop and go to the next.*/
-                        }
-                    }
-                }
-                else
-                {  
-                    /* get list data count */
-                    U64 listCount = 0u;
- 
-                    for (; ch < line + lineLen; ++ch)
-                    {
-                        if (isspace(*ch) == 0)
-                        {
-                            countedProperties++;
-
-                            U8 listCountStrLen;
-                            union PlyScalarUnion listCountU = PlyStrToScalar(ch, property->listCountType, &listCountStrLen);
-                            if (listCountStrLen == 0u) {
-                                return PLY_DATA_TYPE_MISMATCH_ERROR;
-                            }
-                            else {
-                                ch += listCountStrLen;
-                            }
-
-                            U8 sze = PlyGetSizeofScalarType(property->listCountType);
-
-
-                            element->properties[pi].dataLineOffsets[dli] = ploffset;
-
-
-
-                            /*copy list count into data*/
-                            U8* copyTo = (U8*)element->data + curDataOffset;
-                            PlyScalarUnionCpyIntoLocation(copyTo, &listCountU, property->listCountType);
-
+            if (element->dataLineBegins)
+                element->dataLineBegins[dli] = buffer.size - elementBegin;
 
+            r = readAsciiDataLine(&tokenizer, element, programs + ei, dli, &buffer);
+            if (r != PLY_SUCCESS)
+                goto bail;
+        }
+        element->dataSize = buffer.size - elementBegin;
 
-                            listCount = (U64)PlyScaleBytesToD64(&listCountU, property->listCountType);
-                            ploffset += (U32)(sze + PlyGetSizeofScalarType(property->scalarType)*listCount);
+        if (element->dataLineStride == 0u && element->propertyCount == 1u) {
+            setAsciiListArity(scene, element, buffer.data + elementBegin, dense);
+            buffer.size = elementBegin + element->dataSize;
+        }
+    }
 
-                            curDataOffset += sze;
+    if (buffer.size == 0) {
+        plyDealloc(buffer.data);
+        return PLY_SUCCESS; /*nothing to allocate*/
+    }
 
-                            break; /* found the list size */
-                        }
-                    }
+    /* give back whatever the estimate over reserved */
+    if (buffer.size < buffer.capacity) {
+        U8* data = (U8*)plyRealloc(buffer.data, buffer.size);
+        if (data) {
+            buffer.data = data;
+        }
+    }
+    scene->sharedElementData = buffer.data;
 
+    /* now that the data has its final location, the element offsets can become pointers */
+    for (ei = 0; ei < scene->elementCount; ++ei) {
+        scene->elements[ei].data = (U8*)scene->sharedElementData + (U64)(scene->elements[ei].data); /*apply offsets*/
+    }
 
-                    U64 readPropCount=0u;
-                    /* get list items */
-                    for (; ch < line + lineLen; ++ch)
-                    {
-                        if (isspace(*ch) == 0)
-                        {
-                            U8 scalarStrLen;
-                            union PlyScalarUnion dataU = PlyStrToScalar(ch, property->scalarType, &scalarStrLen);
-                            if (scalarStrLen == 0u) {
-                                return PLY_DATA_TYPE_MISMATCH_ERROR;
-                            }
-                            else {
-                                ch += scalarStrLen;
-                            }
-                            
-                            U8 sze = PlyGetSizeofScalarType(property->scalarType);
+    return PLY_SUCCESS;
 
-                           
+bail:
+    plyDealloc(buffer.data);
+    for (ei = 0; ei < scene->elementCount; ++ei) {
+        scene->elements[ei].data = NULL;
+    }
+    return r;
+}
 
-                            /*copy list element into data*/
-                            U8* copyTo = (U8*)element->data + curDataOffset;
-                            PlyScalarUnionCpyIntoLocation(
-                                copyTo, &dataU, property->scalarType);
+/* reads the ASCII data section into rows like readDataASCII, then moves them into the columns of PlyLoadInfo::columnarData */
+static enum PlyResult readDataASCIIColumns(struct PlyScene* scene, struct PlyRowProgram* programs, const U8* dataBegin, const U8* dataLast, const struct PlyLoadInfo* loadInfo)
+{
+    /* the rows are walked once more and released, they need no offset tables and must keep their list counts */
+    struct PlyLoadInfo rowInfo = *loadInfo;
+    rowInfo.compactDataLines = true;
+    rowInfo.denseLists = false;
+    enum PlyResult r = readDataASCII(scene, programs, dataBegin, dataLast, &rowInfo);
+    if (r != PLY_SUCCESS)
+        return r;
+
+    void* columns;
+    r = buildColumns(scene, programs, NULL, NULL, false, false, loadInfo->threadCount, &columns);
+    if (r != PLY_SUCCESS)
+        return r;
+    plyDealloc(scene->sharedElementData);
+    scene->sharedElementData = columns;
+    return PLY_SUCCESS;
+}
 
-                            curDataOffset += sze;
 
-                            if (readPropCount+1 == listCount)
-                            {
-                                readPropCount++;
-                                break; /* all elements have been read */
-                            }
-                            readPropCount++;
 
-                            /* DO NOT BREAK LOOP, KEEP READING UNTIL LINE END */
-                        }
-                    }
 
-                    if (readPropCount<listCount)
 
-                    { /* mismatch between actual list count and expected list count */
-                        return PLY_LIST_COUNT_MISMATCH_ERROR;
-                    }
-                }
-            }
-            ploffset = 0u;
 
-            if (countedProperties != element->propertyCount)
-            {
-                return PLY_MALFORMED_DATA_ERROR;
-            }
 
-            line = getNextLine(&lineLen, dataBegin, dataSize, line, lineLen);
-            if (dli != element->dataLineCount-1 && !line) {
-                return PLY_MALFORMED_DATA_ERROR;
-            }
-        }
-    }
 
-    return PLY_SUCCESS;
-}
 
 
 
@@ -1683,13 +4171,132 @@ static enum PlyResult readDataASCII(struct PlyScene* scene, const U8* dataBegin,
 
 
 
+/* drops the elements that were excluded by PlyLoadInfo::elements once their data has been passed over.
+Bound elements stay in the scene to describe what was written, but have no data of their own. */
+static void removeSkippedElements(struct PlyScene* scene, const struct PlyRowProgram* programs)
+{
+    U32 kept = 0u;
+    U32 ei = 0;
+    for (; ei < scene->elementCount; ++ei)
+    {
+        struct PlyElement* element = scene->elements + ei;
+        if (programs[ei].binding) {
+            element->data = NULL;
+            element->dataSize = 0u;
+        }
+        else if (programs[ei].skip) {
+            sceneDealloc(scene, element->properties);
+            sceneDealloc(scene, element->dataLineBegins);
+            sceneDealloc(scene, element->propertyNames.slots);
+            continue;
+        }
+        if (kept != ei) {
+            scene->elements[kept] = *element;
+        }
+        ++kept;
+    }
+    if (kept != scene->elementCount) {
+        scene->elementCount = kept;
+        rebuildNameTable(&scene->elementNames, (const char*)scene->elements, sizeof(struct PlyElement), kept);
+        scene->elementNames.renameCount = plyElementRenameCount;
+    }
+}
 
+/* removes the properties that PlyLoadInfo::propertySelections left out, before any layout is computed.
+The row programs keep a step for every property in the file. */
+static void dropUnselectedProperties(struct PlyScene* scene, const struct PlyRowProgram* programs)
+{
+    U32 ei = 0;
+    for (; ei < scene->elementCount; ++ei)
+    {
+        struct PlyElement* element = scene->elements + ei;
+        const struct PlyRowProgram* program = programs + ei;
+        if (!program->projected) {
+            continue;
+        }
+        U32 kept = 0u;
+        U32 pi = 0u;
+        for (; pi < program->stepCount; ++pi) {
+            if (program->steps[pi].drop) {
+                continue;
+            }
+            if (kept != pi) {
+                element->properties[kept] = element->properties[pi];
+            }
+            ++kept;
+        }
+        element->propertyCount = kept;
+        rebuildNameTable(&element->propertyNames, (const char*)element->properties, sizeof(struct PlyProperty), kept);
+    }
+}
 
+/* bytes of the data line tables that the kept elements are about to allocate, used to size the first block of a scene arena */
+static U64 getDataLineTablesArenaSize(const struct PlyScene* scene, const struct PlyRowProgram* programs, const struct PlyLoadInfo* loadInfo)
+{
+    if (loadInfo->columnarData && scene->format != PLY_FORMAT_ASCII) {
+        return 0u;
+    }
+    /* columnar ASCII data is parsed into compact data lines first */
+    const bool compact = loadInfo->compactDataLines || loadInfo->columnarData;
+    U64 size = 0u;
+    U32 ei = 0u;
+    for (; ei < scene->elementCount; ++ei)
+    {
+        const struct PlyElement* element = scene->elements + ei;
+        if (programs[ei].skip) {
+            continue;
+        }
+        bool hasList = false;
+        U32 pi = 0u;
+        for (; pi < element->propertyCount; ++pi) {
+            hasList |= element->properties[pi].dataType == PLY_DATA_TYPE_LIST;
+        }
+        if (!compact || hasList) {
+            size += alignArenaSize((U64)element->dataLineCount * sizeof(U64));
+        }
+        if (!compact) {
+            size += element->propertyCount * alignArenaSize((U64)element->dataLineCount * sizeof(U32));
+        }
+    }
+    return size;
+}
 
+/* compiles the row programs of the scene and reads the data section that begins at dataBegin */
+static enum PlyResult readData(struct PlyScene* scene, const U8* dataBegin, const U8* dataLast, const struct PlyLoadInfo* loadInfo)
+{
+    if (scene->format != PLY_FORMAT_ASCII && scene->format != PLY_FORMAT_BINARY_BIG_ENDIAN && scene->format != PLY_FORMAT_BINARY_LITTLE_ENDIAN) {
+        return PLY_MALFORMED_HEADER_ERROR;
+    }
 
+    struct PlyRowProgram* programs;
+    enum PlyResult r = compileRowPrograms(scene, loadInfo, &programs);
+    if (r != PLY_SUCCESS)
+        return r;
 
+    if (scene->format == PLY_FORMAT_ASCII) {
+        compileAsciiDecoders(scene, programs);
+    }
+    dropUnselectedProperties(scene, programs);
 
+    if (loadInfo && loadInfo->sceneArena) {
+        r = moveSceneIntoArena(scene, getDataLineTablesArenaSize(scene, programs, loadInfo));
+        if (r != PLY_SUCCESS) {
+            plyDealloc(programs);
+            return r;
+        }
+    }
 
+    const bool columnar = loadInfo && loadInfo->columnarData;
+    if (scene->format == PLY_FORMAT_ASCII) {
+        r = columnar ? readDataASCIIColumns(scene, programs, dataBegin, dataLast, loadInfo) : readDataASCII(scene, programs, dataBegin, dataLast, loadInfo);
+    }
+    else {
+        r = columnar ? readDataBinaryColumns(scene, programs, dataBegin, dataLast, loadInfo) : readDataBinary(scene, programs, dataBegin, dataLast, loadInfo);
+    }
+    removeSkippedElements(scene, programs);
+    plyDealloc(programs);
+    return r;
+}
 
 enum PlyResult PlyLoadFromMemory(const U8* mem, U64 memSize, struct PlyScene* scene, struct PlyLoadInfo* loadInfo)
 {
@@ -1705,87 +4312,151 @@ enum PlyResult PlyLoadFromMemory(const U8* mem, U64 memSize, struct PlyScene* sc
 
     memset(scene, 0, sizeof(*scene));
 
-    const char* srcline = (const char*)mem;
-    U64 srclineSize = lineLen_s(srcline, (const char*)mem, memSize);
-
     struct PlyElement* curElement = NULL;
-
     bool readingHeader = false;
     bool headerFinished = false;
 
-    U64 i = 0;
-    for (; i < UINT32_MAX; ++i)
+    /* the header is parsed in place, one line at a time */
+    const char* memEnd = (const char*)mem + memSize;
+    const char* cur = (const char*)mem;
+    while (cur < memEnd)
     {
-        if (srcline > (const char*)(mem + memSize)) { break; }
+        const char* lineBreak = (const char*)memchr(cur, '\n', memEnd - cur);
+        const char* lineEnd = lineBreak ? lineBreak : memEnd;
+        const char* next = lineBreak ? lineBreak + 1 : memEnd;
+
+        /* trim surrounding whitespace, including the \r of \r\n line breaks */
+        const char* lineBegin = skipSpaces(cur, lineEnd);
+        while (lineEnd > lineBegin && isspace((unsigned char)lineEnd[-1]) != 0) {
+            --lineEnd;
+        }
+        cur = next;
+        if (lineBegin == lineEnd)
+            continue; /*skip empty line*/
 
-        U32 lineLen;
-        char line[C_PLY_MAX_LINE_LENGTH+1];
+        const enum PlyResult exRes = readHeaderLine(lineBegin, lineEnd - lineBegin, &readingHeader, &headerFinished, &curElement, scene, loadInfo);
+        if (exRes != PLY_SUCCESS)
+            return exRes;
 
-        if (srclineSize == 0)
-            continue; /*skip empty line*/
+        if (headerFinished) {
+            /* the header has ended, control over data traversal is handed to readData */
+            return readData(scene, (const U8*)next, mem + memSize - 1, loadInfo);
+        }
+    }
 
-        parseLine(srcline, srclineSize, line, C_PLY_MAX_LINE_LENGTH, &lineLen);
-        
+    /* the header never ended */
+    return PLY_MALFORMED_HEADER_ERROR;
+}
 
-        if (lineLen > 0)
-        {
-            if (!headerFinished) {
-                static bool lastReadingHeader = false;
-                lastReadingHeader = readingHeader;
-                /* parse header */
-                const enum PlyResult exRes = readHeaderLine(line, lineLen, &readingHeader, &curElement, scene, loadInfo);
+/* 
+* parses a file that has been read into a buffer owned by the loader. 
+* if the scene ends up borrowing its element data from the buffer, the scene takes ownership of it and *fileData is set to NULL */
+static enum PlyResult loadFromOwnedBuffer(U8** fileData, const U64 fileSize, struct PlyScene* scene, struct PlyLoadInfo* loadInfo)
+{
+    struct PlyLoadInfo ownedLoadInfo;
+    if (loadInfo && loadInfo->borrowMemory) {
+        /* nobody else can see the buffer, so it can always be byte swapped in place */
+        ownedLoadInfo = *loadInfo;
+        ownedLoadInfo.borrowedMemoryIsWritable = true;
+        loadInfo = &ownedLoadInfo;
+    }
 
-                if (exRes == PLY_SUCCESS)
-                {
-                    if (!readingHeader && lastReadingHeader==true) {
-                        headerFinished = true;
-                    }
-                }
-                else {
-                    return exRes;
-                }
-            }
-            else {
-                /* the header has ended, read data(the line no. will stop incrementing, */
-                /* control over data traversal is handed to readData) */
+    const enum PlyResult resCode = PlyLoadFromMemory(*fileData, fileSize, scene, loadInfo);
+    if (resCode == PLY_SUCCESS && scene->borrowsElementData) {
+        scene->sharedElementData = *fileData;
+        scene->borrowsElementData = false;
+        *fileData = NULL;
+    }
+    return resCode;
+}
 
-                enum PlyResult exRes = PLY_GENERIC_ERROR;
-                if (scene->format == PLY_FORMAT_ASCII) {
-                    exRes = readDataASCII(scene, (const U8*)srcline, (const U8*)(mem + memSize) - 1);
-                }
-                return exRes;
-            }
-        }
+#if PLY_USE_MMAP
+/*
+* maps a file for parsing. The mapping is followed by at least one zeroed byte so the ascii parsers always find a terminator,
+* and it is private and writable so that binary files can be byte swapped in place without touching the file. */
+static U8* mapFile(const char* fileName, U64* fileSizeOut, U64* mapSizeOut, enum PlyResult* resOut)
+{
+    *fileSizeOut = 0u;
+    *mapSizeOut = 0u;
+    *resOut = PLY_SUCCESS;
 
-        
-        if (headerFinished && (scene->format == PLY_FORMAT_BINARY_BIG_ENDIAN || scene->format == PLY_FORMAT_BINARY_LITTLE_ENDIAN)) {
-            srcline = srcline + srclineSize + strlen("\n");
-            if (srcline > (const char*)mem+memSize) {
-                return PLY_MALFORMED_FILE_ERROR;
-            }
-            enum PlyResult exRes = readDataBinary(scene, (const U8*)srcline, (const U8*)(mem + memSize));
-            return exRes;
-        }
-        else {
-            srcline = getNextLine(&srclineSize, mem, memSize, srcline, srclineSize);
-            if (srcline == NULL) {
-                break;
-            }
-        }
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        *resOut = PLY_FILE_READ_ERROR;
+        return NULL;
     }
 
-    /* the header never ended */
-    if (headerFinished==false) {
-        return PLY_MALFORMED_HEADER_ERROR;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 0) {
+        close(fd);
+        *resOut = PLY_FILE_READ_ERROR;
+        return NULL;
     }
-    if (scene->elementCount > 0) { /*element were expected, but data was never read*/
-        return PLY_MALFORMED_DATA_ERROR;
+    if (st.st_size == 0) {
+        close(fd);
+        return NULL; /* there is nothing to read */
     }
-    return PLY_SUCCESS;
+
+    const U64 fileSize = (U64)st.st_size;
+    const U64 pageSize = (U64)sysconf(_SC_PAGESIZE);
+    const U64 mapSize = ((fileSize + 1u + pageSize - 1u) / pageSize) * pageSize;
+
+    /* reserve the zero padded range first, then place the file over the beginning of it */
+    U8* map = (U8*)mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == (U8*)MAP_FAILED) {
+        close(fd);
+        *resOut = PLY_FAILED_ALLOC_ERROR;
+        return NULL;
+    }
+    if (mmap(map, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(map, mapSize);
+        close(fd);
+        *resOut = PLY_FILE_READ_ERROR;
+        return NULL;
+    }
+    close(fd);
+
+#ifdef MADV_SEQUENTIAL
+    madvise(map, fileSize, MADV_SEQUENTIAL);
+#endif
+#ifdef MADV_HUGEPAGE
+    madvise(map, mapSize, MADV_HUGEPAGE);
+#endif
+
+    *fileSizeOut = fileSize;
+    *mapSizeOut = mapSize;
+    return map;
 }
 
+static void unmapFile(void* map, const U64 mapSize)
+{
+    munmap(map, mapSize);
+}
+#endif /* PLY_USE_MMAP */
+
 enum PlyResult PlyLoadFromDisk(const char* fileName, struct PlyScene* scene, struct PlyLoadInfo* loadInfo)
 {
+#if PLY_USE_MMAP
+    U64 fileSize;
+    U64 mapSize;
+    enum PlyResult resCode;
+    U8* map = mapFile(fileName, &fileSize, &mapSize, &resCode);
+    if (map == NULL) {
+        memset(scene, 0, sizeof(*scene));
+        return resCode;
+    }
+
+    U8* fileData = map;
+    resCode = loadFromOwnedBuffer(&fileData, fileSize, scene, loadInfo);
+    if (fileData == NULL) {
+        /* the scene borrows its element data from the mapping */
+        scene->mappedElementDataSize = mapSize;
+    }
+    else {
+        unmapFile(map, mapSize);
+    }
+    return resCode;
+#else
 	enum PlyResult resCode = PLY_SUCCESS;
 	FILE* fptr = NULL;
 	fopen_s(&fptr, fileName, "rb");
@@ -1819,7 +4490,7 @@ enum PlyResult PlyLoadFromDisk(const char* fileName, struct PlyScene* scene, str
         fclose(fptr);
 
     fileData[fsze] = '\0';
-    resCode=PlyLoadFromMemory(fileData, fsze, scene, loadInfo);
+    resCode = loadFromOwnedBuffer(&fileData, fsze, scene, loadInfo);
 
 bail:
 	if (fileData) {
@@ -1827,6 +4498,7 @@ bail:
 	}
 	
 	return resCode;
+#endif /* !PLY_USE_MMAP */
 }
 
 /* memcpy clamped */
@@ -1867,39 +4539,19 @@ static void memcpy_c(U8* dst, const U8* dstEnd, const U64 cpySize, const U8* src
 /* memcpy clamped advance dest*/
 static void memcpy_ca(U8** dst, const U8* dstEnd, const U64 cpySize, const U8* src, const U8* srcEnd, U64* totalDataLen)
 {
-    if (cpySize == 0)
+    /* srcEnd is one past the end of the source, dstEnd is the last writable byte */
+    U64 size = min(cpySize, (U64)(srcEnd - src));
+    if (size == 0)
         return;
 
-    const U8* cpyEnd = src + cpySize - 1;
     if (*dst) {
-        while (true)
-        {
-            **dst = *src;
-            if (src == srcEnd || src == cpyEnd || *dst == dstEnd) {
-                return;
-            }
-            if (totalDataLen) {
-                (*totalDataLen)++;
-            }
-            src++;
-            if (*dst) {
-                (*dst)++;
-            }
-        }
+        const U64 room = *dst > dstEnd ? 0u : (U64)(dstEnd - *dst) + 1;
+        memcpy(*dst, src, min(size, room));
+        *dst += min(size, room);
     }
-    else {
-        while (true)
-        {
-            if (src == srcEnd || src == cpyEnd) {
-                return;
-            }
-            if (totalDataLen) {
-                (*totalDataLen)++;
-            }
-            src++;
-        }
+    if (totalDataLen) {
+        *totalDataLen += size;
     }
-
 }
 
 /* non-null-terminated strcpy clamped */
@@ -2067,33 +4719,40 @@ enum PlyResult PlySaveToMemory(struct PlyScene* scene, U8* data, U64 dataSize, U
             struct PlyElement* element = scene->elements + ei;
             U64 dli = 0;
             for (; dli < element->dataLineCount; ++dli) {
-                if (element->dataLineBegins == NULL) {
+                if (element->dataLineBegins == NULL && element->dataLineStride == 0u) {
                 #ifndef NDEBUG
                     assert(00 && "DATA LINES WERE EXPECTED FOR AN ELEMENT, BUT THEY WERE NEVER ALLOCATED. IF DATA LINE COUNT OF AN ELEMENT IS GREATER THAN 0, IT MUST HAVE AN ALLOCATED DATA LINES ARRAY.");
                 #endif
                     return PLY_MALFORMED_DATA_ERROR;
                 }
-                const U64 lineBegin = element->dataLineBegins[dli];
                 U32 pi=0;
                 for (; pi < element->propertyCount; ++pi)
                 {
                     if (element->data) {
                         struct PlyProperty* property = element->properties + pi;
-                        const U32 lineOffset = property->dataLineOffsets[dli];
                         if (property->dataType == PLY_DATA_TYPE_LIST) {
                             char str[512];
-                            const U8* copyFrom = (U8*)element->data + lineBegin + lineOffset;
-                            const U32 listCount = PlyScaleBytesToU32(copyFrom, property->listCountType);
+                            const U8* copyFrom = (const U8*)PlyGetPropertyData(element, pi, (U32)dli);
+                            U32 listCount;
                             /*WRITE LIST COUNT*/
-                            PlyDataToString(copyFrom, str, sizeof(str), property->listCountType, writeInfo->F32DecimalCount, writeInfo->D64DecimalCount);
+                            if (property->denseList) {
+                                union PlyScalarUnion u = { .u32 = property->listArity };
+                                U8 countBytes[8];
+                                PlyScalarUnionCpyIntoLocation(countBytes, &u, property->listCountType);
+                                PlyDataToString(countBytes, str, sizeof(str), property->listCountType, writeInfo->F32DecimalCount, writeInfo->D64DecimalCount);
+                                listCount = property->listArity;
+                            }
+                            else {
+                                PlyDataToString(copyFrom, str, sizeof(str), property->listCountType, writeInfo->F32DecimalCount, writeInfo->D64DecimalCount);
+                                listCount = PlyScaleBytesToU32(copyFrom, property->listCountType);
+                                copyFrom += PlyGetSizeofScalarType(property->listCountType);
+                            }
                             nntstrcpy_ca((char**)&cur, (const char*)dataLast, str, writeSizeOut);
                             if (listCount > 0) { /*prevent double space*/
                                 nntstrcpy_ca((char**)&cur, (const char*)dataLast, " ", writeSizeOut);
                             }
 
-                            U8 scalarSize = PlyGetSizeofScalarType(property->listCountType);
-                            copyFrom += scalarSize;
-                            scalarSize = PlyGetSizeofScalarType(property->scalarType);
+                            const U8 scalarSize = PlyGetSizeofScalarType(property->scalarType);
 
                             U32 lsti;
                             for (lsti = 0; lsti < listCount; ++lsti)
@@ -2108,7 +4767,7 @@ enum PlyResult PlySaveToMemory(struct PlyScene* scene, U8* data, U64 dataSize, U
                         }
                         else {
                             char str[512];
-                            const U8* copyFrom = (U8*)element->data + lineBegin + lineOffset;
+                            const U8* copyFrom = (const U8*)PlyGetPropertyData(element, pi, (U32)dli);
                             PlyDataToString(copyFrom, str, sizeof(str), property->scalarType, writeInfo->F32DecimalCount, writeInfo->D64DecimalCount);
 
                             nntstrcpy_ca((char**)&cur, (const char*)dataLast, str, writeSizeOut);
@@ -2132,6 +4791,26 @@ enum PlyResult PlySaveToMemory(struct PlyScene* scene, U8* data, U64 dataSize, U
         U32 ei = 0;
         for (; ei < scene->elementCount; ++ei) {
             struct PlyElement* element = scene->elements + ei;
+            if (!element->data && element->dataLineCount != 0u && element->propertyCount != 0u) {
+                /* the values are in columns, see PlyLoadInfo::columnarData */
+                return PLY_MALFORMED_DATA_ERROR;
+            }
+            if (element->propertyCount == 1u && element->properties[0].denseList) {
+                /* put the list counts that were dropped on load back in front of every data line */
+                const struct PlyProperty* property = element->properties;
+                const U8 listCountSize = PlyGetSizeofScalarType(property->listCountType);
+                union PlyScalarUnion u = { .u32 = property->listArity };
+                U8 countBytes[8];
+                PlyScalarUnionCpyIntoLocation(countBytes, &u, property->listCountType);
+
+                U64 dli = 0;
+                for (; dli < element->dataLineCount; ++dli) {
+                    const U8* line = (const U8*)element->data + dli * element->dataLineStride;
+                    memcpy_ca(&cur, dataLast, listCountSize, countBytes, countBytes + listCountSize, writeSizeOut);
+                    memcpy_ca(&cur, dataLast, element->dataLineStride, line, line + element->dataLineStride, writeSizeOut);
+                }
+                continue;
+            }
             memcpy_ca(&cur, dataLast, element->dataSize, element->data, (U8*)element->data + element->dataSize, writeSizeOut);
         }
     }
@@ -2258,7 +4937,7 @@ enum PlyResult PlyLoadFromDiskW(const wchar_t* fileName, struct PlyScene* scene,
         fclose(fptr);
 
     fileData[fsze] = '\0';
-    resCode = PlyLoadFromMemory(fileData, fsze, scene, loadInfo);
+    resCode = loadFromOwnedBuffer(&fileData, fsze, scene, loadInfo);
 
 bail:
     if (fileData) {
@@ -2274,6 +4953,19 @@ bail:
 
 void PlyDestroyScene(struct PlyScene* scene)
 {
+    if (scene->arena) {
+        /* the elements, names, comments and obj_infos all live in the arena */
+        releaseArena(scene->arena);
+        scene->arena = NULL;
+        scene->elements = NULL;
+        scene->elementCount = 0u;
+        scene->elementNames.slots = NULL;
+        scene->objectInfos = NULL;
+        scene->objectInfoCount = 0u;
+        scene->comments = NULL;
+        scene->commentCount = 0u;
+    }
+
     if (scene->elements) {
         U64 i = 0;
         for (; i < scene->elementCount; ++i)
@@ -2283,7 +4975,7 @@ void PlyDestroyScene(struct PlyScene* scene)
             for (pi = 0; pi < ele->propertyCount; ++pi)
             {
                 if (ele->properties[pi].dataLineOffsets)
-                    free(ele->properties[pi].dataLineOffsets);
+                    plyDealloc(ele->properties[pi].dataLineOffsets);
             }
 
 
@@ -2295,18 +4987,36 @@ void PlyDestroyScene(struct PlyScene* scene)
             {
                 plyDealloc(ele->dataLineBegins);
             }
+            if (ele->propertyNames.slots)
+            {
+                plyDealloc(ele->propertyNames.slots);
+            }
         }
         plyDealloc(scene->elements);
         scene->elementCount = 0u;
         scene->elements = NULL;
     }
+    if (scene->elementNames.slots) {
+        plyDealloc(scene->elementNames.slots);
+    }
+    memset(&scene->elementNames, 0, sizeof(scene->elementNames));
 
     if (scene->sharedElementData) {
-        free(scene->sharedElementData);
+#if PLY_USE_MMAP
+        if (scene->mappedElementDataSize != 0u) {
+            unmapFile(scene->sharedElementData, scene->mappedElementDataSize);
+        }
+        else
+#endif
+        if (!scene->borrowsElementData) {
+            plyDealloc(scene->sharedElementData);
+        }
         scene->sharedElementData = NULL;
+        scene->borrowsElementData = false;
+        scene->mappedElementDataSize = 0u;
     }
     if (scene->objectInfos) {
-        free(scene->objectInfos);
+        plyDealloc(scene->objectInfos);
         scene->objectInfoCount = 0u;
         scene->objectInfos = NULL;
     }
@@ -2315,9 +5025,9 @@ void PlyDestroyScene(struct PlyScene* scene)
         U64 ci;
         for (ci = 0; ci < scene->commentCount; ++ci)
         {
-            free(scene->comments[ci]);
+            plyDealloc(scene->comments[ci]);
         }
-        free(scene->comments);
+        plyDealloc(scene->comments);
         scene->comments = NULL;
         scene->commentCount = 0u;
     }
@@ -2326,14 +5036,17 @@ void PlyDestroyScene(struct PlyScene* scene)
 
 enum PlyResult PlyCreateDataLines(struct PlyElement* element, const U32 linecount)
 {
+    if (element->inArena)
+        return PLY_GENERIC_ERROR;
+
     element->dataLineCount = linecount;
-    return allocateDataLinesForElement(element);
+    return allocateDataLinesForElement(NULL, element, false);
 }
 
 
 enum PlyResult PlyWriteElement(struct PlyScene* scene, struct PlyElement* element)
 {
-    if (checkForElementNameCollision(scene, element->name))
+    if (scene->arena || element->inArena || checkForElementNameCollision(scene, element->name))
         return PLY_GENERIC_ERROR;
 
     if (scene->elementCount == UINT32_MAX - 1) {
@@ -2346,13 +5059,15 @@ enum PlyResult PlyWriteElement(struct PlyScene* scene, struct PlyElement* elemen
     }
     scene->elements = tmp;
     scene->elements[scene->elementCount] = *element;
+    refreshElementNames(scene);
+    addToNameTable(&scene->elementNames, hashName(element->name), scene->elementCount);
     scene->elementCount = newElementCount;
     return PLY_SUCCESS;
 }
 
  enum PlyResult PlyWriteProperty(struct PlyElement* element, struct PlyProperty* property)
 {
-    if (checkForPropertyNameCollision(element, property->name))
+    if (element->inArena || checkForPropertyNameCollision(element, property->name))
         return PLY_GENERIC_ERROR;
 
     if (element->propertyCount == UINT32_MAX - 1) {
@@ -2365,6 +5080,7 @@ enum PlyResult PlyWriteElement(struct PlyScene* scene, struct PlyElement* elemen
     }
     element->properties = tmp;
     element->properties[element->propertyCount] = *property;
+    addToNameTable(&element->propertyNames, hashName(property->name), element->propertyCount);
     element->propertyCount = newPropertyCount;
     return PLY_SUCCESS;
 }
@@ -2372,6 +5088,9 @@ enum PlyResult PlyWriteElement(struct PlyScene* scene, struct PlyElement* elemen
 
 enum PlyResult PlyWriteObjectInfo(struct PlyScene* scene, const char* name, double value)
 {
+    if (scene->arena)
+        return PLY_GENERIC_ERROR;
+
     const U32 newcount = scene->objectInfoCount + 1;
     if (newcount < scene->objectInfoCount)
         return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
@@ -2398,6 +5117,9 @@ enum PlyResult PlyWriteComment(struct PlyScene* scene, const char* comment)
     }
 #endif
 
+    if (scene->arena)
+        return PLY_GENERIC_ERROR;
+
     const U64 commentLen = strlen(comment);
 
     const U32 newcount = scene->commentCount + 1;
@@ -2432,6 +5154,9 @@ enum PlyResult PlyWriteComment(struct PlyScene* scene, const char* comment)
 
 enum PlyResult PlyWriteData(struct PlyElement* element, const U32 datalineIdx, const U32 pi, const union PlyScalarUnion value)
 {    
+    if (element->inArena) {
+        return PLY_GENERIC_ERROR;
+    }
     if (element->propertyCount == 0) {
 #ifndef NDEBUG
         assert("PlyWriteData: CANNOT WRITE DATA TO ELEMENT WHICH HAS NO PROPERTIES");
@@ -2446,10 +5171,9 @@ enum PlyResult PlyWriteData(struct PlyElement* element, const U32 datalineIdx, c
 #endif
         return PLY_DATA_TYPE_MISMATCH_ERROR;
     }
-
-
-
-
+    if (!pr->dataLineOffsets || !element->dataLineBegins) {
+        return PLY_GENERIC_ERROR; /* loaded with compactDataLines, columnarData or elementBindings */
+    }
 
     const U8 scalarSize = PlyGetSizeofScalarType(pr->scalarType);
     if (element->dataSize + scalarSize < element->dataSize) {
@@ -2488,6 +5212,9 @@ enum PlyResult PlyWriteData(struct PlyElement* element, const U32 datalineIdx, c
 
 PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataList(struct PlyElement* element, const U32 datalineIdx, const U32 pi, const U32 listCount, const void* values)
 {
+    if (element->inArena) {
+        return PLY_GENERIC_ERROR;
+    }
     if (element->propertyCount == 0) {
 #ifndef NDEBUG
         assert("PlyWriteDataList: CANNOT WRITE DATA TO ELEMENT WHICH HAS NO PROPERTIES");
@@ -2503,6 +5230,9 @@ PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataList(struct PlyElement* element
 
         return PLY_DATA_TYPE_MISMATCH_ERROR;
     }
+    if (!pr->dataLineOffsets || !element->dataLineBegins) {
+        return PLY_GENERIC_ERROR; /* loaded with compactDataLines, columnarData or elementBindings */
+    }
     const U32 listDataSize = PlyGetSizeofScalarType(pr->scalarType) * listCount;
     const U32 totalListSize = PlyGetSizeofScalarType(pr->listCountType) + listDataSize;
 
@@ -2535,45 +5265,396 @@ PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataList(struct PlyElement* element
         if (nxtDataLineBegin == 0) {
             nxtDataLineBegin = element->dataLineBegins[datalineIdx];
         }
-        nxtDataLineBegin += totalListSize;
-        element->dataLineBegins[datalineIdx + 1] = nxtDataLineBegin;
+        nxtDataLineBegin += totalListSize;
+        element->dataLineBegins[datalineIdx + 1] = nxtDataLineBegin;
+    }
+    if (pi < element->propertyCount - 1) {
+        struct PlyProperty* prNxt = element->properties + pi + 1;
+        prNxt->dataLineOffsets[datalineIdx] = dlOffset + totalListSize;
+    }
+
+    return PLY_SUCCESS;
+}
+
+
+
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataByName(struct PlyElement* element, const U32 datalineIdx, const char* propertyName, const union PlyScalarUnion value)
+{
+    const struct PlyNameHandle handle = PlyInternName(propertyName);
+    return PlyWriteDataByHandle(element, datalineIdx, &handle, value);
+}
+
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataListByName(struct PlyElement* element, const U32 datalineIdx, const char* propertyName, const U32 listCount, const void* values)
+{
+    const struct PlyNameHandle handle = PlyInternName(propertyName);
+    return PlyWriteDataListByHandle(element, datalineIdx, &handle, listCount, values);
+}
+
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataByHandle(struct PlyElement* element, const U32 datalineIdx, const struct PlyNameHandle* propertyName, const union PlyScalarUnion value)
+{
+    const I64 pi = PlyGetPropertyIndexByHandle(element, propertyName);
+    if (pi < 0) {
+        return PLY_GENERIC_ERROR;
+    }
+    return PlyWriteData(element, datalineIdx, (U32)pi, value);
+}
+
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataListByHandle(struct PlyElement* element, const U32 datalineIdx, const struct PlyNameHandle* propertyName, const U32 listCount, const void* values)
+{
+    const I64 pi = PlyGetPropertyIndexByHandle(element, propertyName);
+    if (pi < 0) {
+        return PLY_GENERIC_ERROR;
+    }
+    return PlyWriteDataList(element, datalineIdx, (U32)pi, listCount, values);
+}
+
+/* number of values that PlyExtractColumn gathers before converting them, few enough for the block to live on the stack */
+#define PLY_EXTRACT_BLOCK_VALUES 256u
+
+#if PLY_USE_SSE2
+/* widens 8 16 bit integers to two vectors of 4 32 bit integers */
+PLY_INLINE void widenShortsToInt32(const __m128i shorts, const bool isSigned, __m128i* out)
+{
+    if (isSigned) {
+        out[0] = _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16);
+        out[1] = _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16);
+    }
+    else {
+        const __m128i zero = _mm_setzero_si128();
+        out[0] = _mm_unpacklo_epi16(shorts, zero);
+        out[1] = _mm_unpackhi_epi16(shorts, zero);
+    }
+}
+
+/* widens 16 bytes to four vectors of 4 32 bit integers */
+PLY_INLINE void widenBytesToInt32(const __m128i bytes, const bool isSigned, __m128i* out)
+{
+    const __m128i zero = _mm_setzero_si128();
+    if (isSigned) {
+        widenShortsToInt32(_mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8), true, out);
+        widenShortsToInt32(_mm_srai_epi16(_mm_unpackhi_epi8(bytes, bytes), 8), true, out + 2);
+    }
+    else {
+        widenShortsToInt32(_mm_unpacklo_epi8(bytes, zero), false, out);
+        widenShortsToInt32(_mm_unpackhi_epi8(bytes, zero), false, out + 2);
+    }
+}
+
+/* converts 4 32 bit integers to floats, divides them by scale and clamps them to lowest */
+PLY_INLINE void storeInt32AsFloat(U8* dst, const __m128i v, const __m128 scale, const __m128 lowest)
+{
+    _mm_storeu_ps((float*)dst, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(v), scale), lowest));
+}
+#endif /* PLY_USE_SSE2 */
+
+/* converts count contiguous values in host byte order from srcType to dstType. Common pairs have SIMD loops,
+everything else goes through a double like a PlyPropertyBinding does, and both give the same results. */
+static void convertValues(const U8* src, const enum PlyScalarType srcType, U8* dst, const enum PlyScalarType dstType, const U64 count, const bool normalized)
+{
+    const U8 srcSize = PlyGetSizeofScalarType(srcType);
+    const U8 dstSize = PlyGetSizeofScalarType(dstType);
+    if (srcType == dstType) {
+        memcpy(dst, src, count * srcSize);
+        return;
+    }
+
+    U64 i = 0u;
+#if PLY_USE_SSE2
+    if (dstType == PLY_SCALAR_TYPE_FLOAT)
+    {
+        const bool isSigned = srcType == PLY_SCALAR_TYPE_CHAR || srcType == PLY_SCALAR_TYPE_SHORT || srcType == PLY_SCALAR_TYPE_INT;
+        const __m128 lowest = _mm_set1_ps(normalized && isSigned ? -1.0f : -FLT_MAX);
+        __m128i ints[4];
+        switch (srcType)
+        {
+        case PLY_SCALAR_TYPE_CHAR:
+        case PLY_SCALAR_TYPE_UCHAR: {
+            const __m128 scale = _mm_set1_ps(!normalized ? 1.0f : (isSigned ? 127.0f : 255.0f));
+            for (; i + 16u <= count; i += 16u) {
+                widenBytesToInt32(_mm_loadu_si128((const __m128i*)(src + i)), isSigned, ints);
+                storeInt32AsFloat(dst + i * 4u, ints[0], scale, lowest);
+                storeInt32AsFloat(dst + i * 4u + 16u, ints[1], scale, lowest);
+                storeInt32AsFloat(dst + i * 4u + 32u, ints[2], scale, lowest);
+                storeInt32AsFloat(dst + i * 4u + 48u, ints[3], scale, lowest);
+            }
+            break;
+        }
+        case PLY_SCALAR_TYPE_SHORT:
+        case PLY_SCALAR_TYPE_USHORT: {
+            const __m128 scale = _mm_set1_ps(!normalized ? 1.0f : (isSigned ? 32767.0f : 65535.0f));
+            for (; i + 8u <= count; i += 8u) {
+                widenShortsToInt32(_mm_loadu_si128((const __m128i*)(src + i * 2u)), isSigned, ints);
+                storeInt32AsFloat(dst + i * 4u, ints[0], scale, lowest);
+                storeInt32AsFloat(dst + i * 4u + 16u, ints[1], scale, lowest);
+            }
+            break;
+        }
+        case PLY_SCALAR_TYPE_INT:
+            /* a float can not divide by 2^31 - 1 the same way a double does, so only the plain conversion is vectorized */
+            if (!normalized) {
+                for (; i + 4u <= count; i += 4u) {
+                    _mm_storeu_ps((float*)(dst + i * 4u), _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(src + i * 4u))));
+                }
+            }
+            break;
+        case PLY_SCALAR_TYPE_DOUBLE:
+            for (; i + 4u <= count; i += 4u) {
+                const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(src + i * 8u)));
+                const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(src + i * 8u + 16u)));
+                _mm_storeu_ps((float*)(dst + i * 4u), _mm_movelh_ps(lo, hi));
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    else if (dstType == PLY_SCALAR_TYPE_DOUBLE && srcType == PLY_SCALAR_TYPE_FLOAT)
+    {
+        for (; i + 4u <= count; i += 4u) {
+            const __m128 v = _mm_loadu_ps((const float*)(src + i * 4u));
+            _mm_storeu_pd((double*)(dst + i * 8u), _mm_cvtps_pd(v));
+            _mm_storeu_pd((double*)(dst + i * 8u + 16u), _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+        }
+    }
+#endif /* PLY_USE_SSE2 */
+
+    const PlyLoadValueFn load = getLoadValueFn(srcType, normalized);
+    const PlyStoreValueFn store = getStoreValueFn(dstType, normalized);
+    for (; i < count; ++i) {
+        store(dst + i * dstSize, load(src + i * srcSize));
+    }
+}
+
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyExtractColumn(const struct PlyElement* element, const U32 propertyIdx, const enum PlyScalarType dstType, void* dst, const U32 rowBegin, const U32 rowCount, const char normalized)
+{
+    if (propertyIdx >= element->propertyCount || (U64)rowBegin + rowCount > element->dataLineCount) {
+        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+    }
+    const struct PlyProperty* property = element->properties + propertyIdx;
+    if (property->dataType != PLY_DATA_TYPE_SCALAR || !getLoadValueFn(property->scalarType, false) || !getStoreValueFn(dstType, false)) {
+        return PLY_DATA_TYPE_MISMATCH_ERROR;
+    }
+    if (rowCount == 0u) {
+        return PLY_SUCCESS;
+    }
+
+    const enum PlyScalarType srcType = property->scalarType;
+    const U8 srcSize = PlyGetSizeofScalarType(srcType);
+    const U8 dstSize = PlyGetSizeofScalarType(dstType);
+    U8* out = (U8*)dst;
+    if (!element->data) {
+        if (!property->columnData) {
+            return PLY_MALFORMED_DATA_ERROR;
+        }
+        /* loaded with columnarData, the values are contiguous already */
+        convertValues((const U8*)property->columnData + (U64)rowBegin * srcSize, srcType, out, dstType, rowCount, normalized != 0);
+        return PLY_SUCCESS;
     }
-    if (pi < element->propertyCount - 1) {
-        struct PlyProperty* prNxt = element->properties + pi + 1;
-        prNxt->dataLineOffsets[datalineIdx] = dlOffset + totalListSize;
+
+    /* the values of an element with a stride are a fixed distance apart, otherwise every data line is looked up */
+    const U64 stride = element->dataLineStride;
+    const U8* values = NULL;
+    if (stride != 0u) {
+        values = (const U8*)element->data + (U64)rowBegin * stride + property->dataLineOffset;
+        if (stride == srcSize || srcType == dstType) {
+            if (stride == srcSize) {
+                convertValues(values, srcType, out, dstType, rowCount, normalized != 0);
+            }
+            else {
+                gatherStridedValues(out, values, rowCount, stride, srcSize);
+            }
+            return PLY_SUCCESS;
+        }
     }
 
+    U8 block[PLY_EXTRACT_BLOCK_VALUES * 8u];
+    U64 done = 0u;
+    while (done < rowCount)
+    {
+        const U64 count = min((U64)PLY_EXTRACT_BLOCK_VALUES, rowCount - done);
+        if (values) {
+            gatherStridedValues(block, values + done * stride, count, stride, srcSize);
+        }
+        else {
+            U64 i = 0u;
+            for (; i < count; ++i) {
+                memcpy(block + i * srcSize, PlyGetPropertyData(element, propertyIdx, (U32)(rowBegin + done + i)), srcSize);
+            }
+        }
+        convertValues(block, srcType, out + done * dstSize, dstType, count, normalized != 0);
+        done += count;
+    }
     return PLY_SUCCESS;
 }
 
+/* fewest data lines worth a thread of PlyExtractList */
+#define PLY_MIN_PARALLEL_EXTRACT_LINES ((U64)1u << 16u)
 
+struct PlyListExtractContext
+{
+    const struct PlyElement* element;
+    U32 propertyIdx;
+    enum PlyScalarType dstType;
+    bool normalized;
+    U64* offsets;
+    U8* values; /* NULL if only the offsets are wanted */
+    U32 workerCount;
+    U64 workerTotals[PLY_MAX_THREADS];
+};
+
+PLY_INLINE void getListExtractRange(const struct PlyListExtractContext* ctx, const U32 workerIdx, U64* begin, U64* end)
+{
+    const U64 lineCount = ctx->element->dataLineCount;
+    *begin = lineCount * workerIdx / ctx->workerCount;
+    *end = lineCount * (workerIdx + 1u) / ctx->workerCount;
+}
 
-PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataByName(struct PlyElement* element, const U32 datalineIdx, const char* propertyName, const union PlyScalarUnion value)
+/* first pass of the prefix sum, every worker sums the list counts of its own data lines */
+static void countListsWorker(void* ctxPtr, U32 workerIdx)
 {
-    
-    U32 pi = 0;
-    for (; pi < element->propertyCount; pi++) {
-        struct PlyProperty* pr = element->properties + pi;
-        if (streql(pr->name, propertyName)) {
-            break;
+    struct PlyListExtractContext* ctx = (struct PlyListExtractContext*)ctxPtr;
+    const struct PlyProperty* property = ctx->element->properties + ctx->propertyIdx;
+    U64 dli = 0u, end = 0u, total = 0u;
+    getListExtractRange(ctx, workerIdx, &dli, &end);
+    for (; dli < end; ++dli) {
+        if (property->listArity != 0u) {
+            total += property->listArity;
+        }
+        else {
+            total += PlyScaleBytesToU64((const U8*)PlyGetPropertyData(ctx->element, ctx->propertyIdx, (U32)dli), property->listCountType);
         }
+        ctx->offsets[dli + 1u] = total;
+    }
+    ctx->workerTotals[workerIdx] = total;
+}
+
+/* second pass, every worker offsets its sums by the total of the workers before it and converts its lists.
+Short lists are gathered into a block so they are converted together. */
+static void fillListsWorker(void* ctxPtr, U32 workerIdx)
+{
+    struct PlyListExtractContext* ctx = (struct PlyListExtractContext*)ctxPtr;
+    const struct PlyElement* element = ctx->element;
+    const struct PlyProperty* property = element->properties + ctx->propertyIdx;
+    U64 begin = 0u, end = 0u, dli = 0u;
+    getListExtractRange(ctx, workerIdx, &begin, &end);
+
+    /* offsets[begin] belongs to the previous worker, which may still be writing it */
+    U64 base = 0u;
+    U32 wi = 0u;
+    for (; wi < workerIdx; ++wi) {
+        base += ctx->workerTotals[wi];
+    }
+    for (dli = begin; dli < end; ++dli) {
+        ctx->offsets[dli + 1u] += base;
+    }
+    if (!ctx->values || begin == end) {
+        return;
     }
 
-    return PlyWriteData(element,datalineIdx,pi,value);
+    const enum PlyScalarType srcType = property->scalarType;
+    const U8 srcSize = PlyGetSizeofScalarType(srcType);
+    const U8 dstSize = PlyGetSizeofScalarType(ctx->dstType);
+    if (property->denseList) {
+        /* the lists are one contiguous run of values already */
+        const U8* src = (const U8*)element->data + begin * element->dataLineStride;
+        convertValues(src, srcType, ctx->values + base * dstSize, ctx->dstType, ctx->offsets[end] - base, ctx->normalized);
+        return;
+    }
+
+    const U8 countSize = PlyGetSizeofScalarType(property->listCountType);
+    U8 block[PLY_EXTRACT_BLOCK_VALUES * 8u];
+    U64 blockCount = 0u;
+    U64 blockFirst = 0u;
+    U64 first = base;
+    for (dli = begin; dli < end; first = ctx->offsets[++dli])
+    {
+        const U8* src = (const U8*)PlyGetPropertyData(element, ctx->propertyIdx, (U32)dli) + countSize;
+        const U64 count = ctx->offsets[dli + 1u] - first;
+        if (srcType == ctx->dstType) {
+            memcpy(ctx->values + first * dstSize, src, count * srcSize);
+            continue;
+        }
+        if (blockCount + count > PLY_EXTRACT_BLOCK_VALUES && blockCount != 0u) {
+            convertValues(block, srcType, ctx->values + blockFirst * dstSize, ctx->dstType, blockCount, ctx->normalized);
+            blockCount = 0u;
+        }
+        if (count > PLY_EXTRACT_BLOCK_VALUES) {
+            convertValues(src, srcType, ctx->values + first * dstSize, ctx->dstType, count, ctx->normalized);
+            continue;
+        }
+        if (blockCount == 0u) {
+            blockFirst = first;
+        }
+        memcpy(block + blockCount * srcSize, src, count * srcSize);
+        blockCount += count;
+    }
+    if (blockCount != 0u) {
+        convertValues(block, srcType, ctx->values + blockFirst * dstSize, ctx->dstType, blockCount, ctx->normalized);
+    }
 }
 
-PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataListByName(struct PlyElement* element, const U32 datalineIdx, const char* propertyName, const U32 listCount, const void* values)
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyExtractList(const struct PlyElement* element, const U32 propertyIdx, const enum PlyScalarType dstType, U64* offsets, void* values, const U64 valueCapacity, U32 threadCount, const char normalized)
 {
-    
-    U32 pi = 0;
-    for (; pi < element->propertyCount; pi++) {
-        struct PlyProperty* pr = element->properties + pi;
-        if (streql(pr->name, propertyName)) {
-            break;
+    if (propertyIdx >= element->propertyCount) {
+        return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+    }
+    const struct PlyProperty* property = element->properties + propertyIdx;
+    if (property->dataType != PLY_DATA_TYPE_LIST || !getLoadValueFn(property->scalarType, false) || !getStoreValueFn(dstType, false)) {
+        return PLY_DATA_TYPE_MISMATCH_ERROR;
+    }
+
+    /* an element without data lines still gets its single offset */
+    offsets[0] = 0u;
+    const U64 lineCount = element->dataLineCount;
+    if (!element->data) {
+        if (!property->columnData || !property->listOffsets) {
+            return lineCount == 0u ? PLY_SUCCESS : PLY_MALFORMED_DATA_ERROR;
+        }
+        /* loaded with columnarData, the lists are in CSR form already */
+        memcpy(offsets, property->listOffsets, (lineCount + 1u) * sizeof(U64));
+        if (!values) {
+            return PLY_SUCCESS;
         }
+        if (offsets[lineCount] > valueCapacity) {
+            return PLY_EXCEEDS_BOUND_LIMITS_ERROR;
+        }
+        convertValues((const U8*)property->columnData, property->scalarType, (U8*)values, dstType, offsets[lineCount], normalized != 0);
+        return PLY_SUCCESS;
+    }
+
+    if (threadCount > PLY_MAX_THREADS) {
+        threadCount = PLY_MAX_THREADS;
     }
+    if (lineCount / PLY_MIN_PARALLEL_EXTRACT_LINES < threadCount) {
+        threadCount = (U32)(lineCount / PLY_MIN_PARALLEL_EXTRACT_LINES);
+    }
+    if (threadCount < 1u) {
+        threadCount = 1u;
+    }
+
+    struct PlyListExtractContext ctx;
+    ctx.element = element;
+    ctx.propertyIdx = propertyIdx;
+    ctx.dstType = dstType;
+    ctx.normalized = normalized != 0;
+    ctx.offsets = offsets;
+    ctx.values = NULL;
+    ctx.workerCount = threadCount;
+
+    runParallel(countListsWorker, &ctx, ctx.workerCount);
 
-    return PlyWriteDataList(element,datalineIdx,pi,listCount,values);
+    U64 valueCount = 0u;
+    U32 wi = 0u;
+    for (; wi < ctx.workerCount; ++wi) {
+        valueCount += ctx.workerTotals[wi];
+    }
+    /* the offsets are finished either way, so a caller can size values from offsets[dataLineCount] and call again */
+    const bool fits = valueCount <= valueCapacity;
+    if (values && fits) {
+        ctx.values = (U8*)values;
+    }
+    runParallel(fillListsWorker, &ctx, ctx.workerCount);
+    return values && !fits ? PLY_EXCEEDS_BOUND_LIMITS_ERROR : PLY_SUCCESS;
 }
 
 void PlyDataToString(const U8* data, char* dst, const U16 dstSize, enum PlyScalarType type, const U8 F32DecimalCount, const U16 D64DecimalCount)
@@ -2629,384 +5710,801 @@ void PlyDataToString(const U8* data, char* dst, const U16 dstSize, enum PlyScala
 
 U8 strtou8(const char* str, U8* strLenOut)
 {
-    if (strLenOut) /* 0-init */
-        *strLenOut = 0;
-    U8 num = 0;
-    const U8 max_digits = 3;
-    
-    I8 i = 0;
-    for (; i <= max_digits; ++i)
-    {
-        if (i == max_digits) {
-            if (!(str[i] == '\0' || str[i] == '\r' || str[i] == '\n') && !isspace(str[i])) {
-                *strLenOut = 0x0;
-                return 0x0;
-            }
-        }
-        else {
-
-            if (str[i] < '0' || str[i] > '9') {
-                break;
-            }
-            else {
-                if (num > (UINT8_MAX - (str[i] - '0')) / 10) {
-                    if (strLenOut)
-                        *strLenOut = 0;
-                    return 0;
-                }
-                num = num * 10 + (str[i] - 48);
-                if (strLenOut)
-                    (*strLenOut)++;
-            }
-        }
-    }
-    return num;
+    U64 num;
+    const U8 len = parseUnsignedBounded(str, integerRunLength(str), UINT8_MAX, &num);
+    if (strLenOut)
+        *strLenOut = len;
+    return (U8)num;
 }
 
 U16 strtou16(const char* str, U8* strLenOut)
 {
-    if (strLenOut) /* 0 - init */
-        *strLenOut = 0;
-    U16 num = 0;
-    const U8 max_digits = 5;
-    I8 i = 0;
-    for (; i <= max_digits; ++i)
-    {
-        if (i == max_digits) {
-            if (!(str[i] == '\0' || str[i] == '\r' || str[i] == '\n') && !isspace(str[i])) {
-                *strLenOut = 0x0;
-                return 0x0;
-            }
-        }
-        else {
-            if (str[i] < '0' || str[i] > '9') {
-                break;
-            }
-            else {
-                if (num > (UINT16_MAX - (str[i] - '0')) / 10) {
-                    if (strLenOut)
-                        *strLenOut = 0;
-                    return 0;
-                }
-                num = num * 10 + (str[i] - 48);
-                if (strLenOut)
-                    (*strLenOut)++;
-            }
-        }
-    }
-    return num;
+    U64 num;
+    const U8 len = parseUnsignedBounded(str, integerRunLength(str), UINT16_MAX, &num);
+    if (strLenOut)
+        *strLenOut = len;
+    return (U16)num;
 }
 
 U32 strtou32(const char* str, U8* strLenOut)
 {
-    if (strLenOut) /* 0-init */
-        *strLenOut = 0;
-    U32 num = 0;
-
-    const U8 max_digits = 10;
-    I8 i = 0;
-    for (; i <= max_digits; ++i)
-    {
-        if (i == max_digits) {
-            if (!(str[i] == '\0' || str[i] == '\r' || str[i] == '\n') && !isspace(str[i])) {
-                *strLenOut = 0x0;
-                return 0x0;
-            }
-        }
-        else {
-            if (str[i] < '0' || str[i] > '9') {
-                break;
-            }
-            else {
-                if (num > (UINT32_MAX - (str[i] - '0')) / 10) {
-                    if (strLenOut)
-                        *strLenOut = 0;
-                    return 0;
-                }
-                num = num * 10 + (str[i] - 48);
-                if (strLenOut)
-                    (*strLenOut)++;
-            }
-        }
-    }
-    return num;
+    U64 num;
+    const U8 len = parseUnsignedBounded(str, integerRunLength(str), UINT32_MAX, &num);
+    if (strLenOut)
+        *strLenOut = len;
+    return (U32)num;
 }
 
 U64 strtou64(const char* str, U8* strLenOut)
 {
-    if (strLenOut) /* 0-init */
-        *strLenOut = 0;
-    U32 num = 0;
-    const U8 max_digits = 20;
-    I8 i = 0;
-    for (; i <= max_digits; ++i)
-    {
-        if (i == max_digits) {
-            if (!(str[i] == '\0' || str[i] == '\r' || str[i] == '\n') && !isspace(str[i])) {
-                *strLenOut = 0x0;
-                return 0x0;
-            }
-        }
-        else {
-            if (num > (UINT64_MAX - (str[i]-'0')) / 10) {
-                if (strLenOut)
-                    *strLenOut = 0;
-                return 0;
-            }
-            if (str[i] < '0' || str[i] > '9') {
-                break;
-            }
-            else {
-                num = num * 10 + (str[i] - 48);
-                if (strLenOut)
-                    (*strLenOut)++;
-            }
-        }
-    }
+    U64 num;
+    const U8 len = parseUnsignedBounded(str, integerRunLength(str), UINT64_MAX, &num);
+    if (strLenOut)
+        *strLenOut = len;
     return num;
 }
 
 
 I8 strtoi8(const char* str, U8* strLenOut)
 {
-    if (strLenOut) /* 0-init */
-        *strLenOut = 0;
-    I8 num = 0;
-    char negative = 0u;
-    if (*str == '-') {
-        negative = 1;
-        str++;
-    }
-    const U8 max_digits = 3;
-    I8 i = 0;
-    for (; i <= max_digits; ++i)
-    {
-        if (i == max_digits) {
-            if (!(str[i] == '\0' || str[i] == '\r' || str[i] == '\n') && !isspace(str[i])) {
-                *strLenOut = 0x0;
-                return 0x0;
-            }
+    I64 num;
+    const U8 len = parseSignedBounded(str, integerRunLength(str), INT8_MAX, &num);
+    if (strLenOut)
+        *strLenOut = len;
+    return (I8)num;
+}
+
+I16 strtoi16(const char* str, U8* strLenOut)
+{
+    I64 num;
+    const U8 len = parseSignedBounded(str, integerRunLength(str), INT16_MAX, &num);
+    if (strLenOut)
+        *strLenOut = len;
+    return (I16)num;
+}
+
+I32 strtoi32(const char* str, U8* strLenOut)
+{
+    I64 num;
+    const U8 len = parseSignedBounded(str, integerRunLength(str), INT32_MAX, &num);
+    if (strLenOut)
+        *strLenOut = len;
+    return (I32)num;
+}
+
+I64 strtoi64(const char* str, U8* strLenOut)
+{
+    I64 num;
+    const U8 len = parseSignedBounded(str, integerRunLength(str), INT64_MAX, &num);
+    if (strLenOut)
+        *strLenOut = len;
+    return num;
+}
+
+
+/* DECIMAL TO BINARY FLOATING POINT CONVERSION
+Floats are parsed without strtof/strtod, so that the result does not depend on the locale.
+Values with up to 19 significant digits are converted with the Eisel-Lemire algorithm, which is correctly rounded.
+If more digits make the result ambiguous, or the text is not a plain decimal (inf, nan, hex), libc is used as a fallback. */
+
+#define PLY_SMALLEST_POWER_OF_FIVE (-342)
+#define PLY_LARGEST_POWER_OF_FIVE 308
+
+/* 128 bit approximations of 5^q for q in [-342, 308], most significant word first */
+static const U64 plyPowersOfFive128[] = {
+    0xeef453d6923bd65au, 0x113faa2906a13b3fu, 0x9558b4661b6565f8u, 0x4ac7ca59a424c507u,
+    0xbaaee17fa23ebf76u, 0x5d79bcf00d2df649u, 0xe95a99df8ace6f53u, 0xf4d82c2c107973dcu,
+    0x91d8a02bb6c10594u, 0x79071b9b8a4be869u, 0xb64ec836a47146f9u, 0x9748e2826cdee284u,
+    0xe3e27a444d8d98b7u, 0xfd1b1b2308169b25u, 0x8e6d8c6ab0787f72u, 0xfe30f0f5e50e20f7u,
+    0xb208ef855c969f4fu, 0xbdbd2d335e51a935u, 0xde8b2b66b3bc4723u, 0xad2c788035e61382u,
+    0x8b16fb203055ac76u, 0x4c3bcb5021afcc31u, 0xaddcb9e83c6b1793u, 0xdf4abe242a1bbf3du,
+    0xd953e8624b85dd78u, 0xd71d6dad34a2af0du, 0x87d4713d6f33aa6bu, 0x8672648c40e5ad68u,
+    0xa9c98d8ccb009506u, 0x680efdaf511f18c2u, 0xd43bf0effdc0ba48u, 0x0212bd1b2566def2u,
+    0x84a57695fe98746du, 0x014bb630f7604b57u, 0xa5ced43b7e3e9188u, 0x419ea3bd35385e2du,
+    0xcf42894a5dce35eau, 0x52064cac828675b9u, 0x818995ce7aa0e1b2u, 0x7343efebd1940993u,
+    0xa1ebfb4219491a1fu, 0x1014ebe6c5f90bf8u, 0xca66fa129f9b60a6u, 0xd41a26e077774ef6u,
+    0xfd00b897478238d0u, 0x8920b098955522b4u, 0x9e20735e8cb16382u, 0x55b46e5f5d5535b0u,
+    0xc5a890362fddbc62u, 0xeb2189f734aa831du, 0xf712b443bbd52b7bu, 0xa5e9ec7501d523e4u,
+    0x9a6bb0aa55653b2du, 0x47b233c92125366eu, 0xc1069cd4eabe89f8u, 0x999ec0bb696e840au,
+    0xf148440a256e2c76u, 0xc00670ea43ca250du, 0x96cd2a865764dbcau, 0x380406926a5e5728u,
+    0xbc807527ed3e12bcu, 0xc605083704f5ecf2u, 0xeba09271e88d976bu, 0xf7864a44c633682eu,
+    0x93445b8731587ea3u, 0x7ab3ee6afbe0211du, 0xb8157268fdae9e4cu, 0x5960ea05bad82964u,
+    0xe61acf033d1a45dfu, 0x6fb92487298e33bdu, 0x8fd0c16206306babu, 0xa5d3b6d479f8e056u,
+    0xb3c4f1ba87bc8696u, 0x8f48a4899877186cu, 0xe0b62e2929aba83cu, 0x331acdabfe94de87u,
+    0x8c71dcd9ba0b4925u, 0x9ff0c08b7f1d0b14u, 0xaf8e5410288e1b6fu, 0x07ecf0ae5ee44dd9u,
+    0xdb71e91432b1a24au, 0xc9e82cd9f69d6150u, 0x892731ac9faf056eu, 0xbe311c083a225cd2u,
+    0xab70fe17c79ac6cau, 0x6dbd630a48aaf406u, 0xd64d3d9db981787du, 0x092cbbccdad5b108u,
+    0x85f0468293f0eb4eu, 0x25bbf56008c58ea5u, 0xa76c582338ed2621u, 0xaf2af2b80af6f24eu,
+    0xd1476e2c07286faau, 0x1af5af660db4aee1u, 0x82cca4db847945cau, 0x50d98d9fc890ed4du,
+    0xa37fce126597973cu, 0xe50ff107bab528a0u, 0xcc5fc196fefd7d0cu, 0x1e53ed49a96272c8u,
+    0xff77b1fcbebcdc4fu, 0x25e8e89c13bb0f7au, 0x9faacf3df73609b1u, 0x77b191618c54e9acu,
+    0xc795830d75038c1du, 0xd59df5b9ef6a2417u, 0xf97ae3d0d2446f25u, 0x4b0573286b44ad1du,
+    0x9becce62836ac577u, 0x4ee367f9430aec32u, 0xc2e801fb244576d5u, 0x229c41f793cda73fu,
+    0xf3a20279ed56d48au, 0x6b43527578c1110fu, 0x9845418c345644d6u, 0x830a13896b78aaa9u,
+    0xbe5691ef416bd60cu, 0x23cc986bc656d553u, 0xedec366b11c6cb8fu, 0x2cbfbe86b7ec8aa8u,
+    0x94b3a202eb1c3f39u, 0x7bf7d71432f3d6a9u, 0xb9e08a83a5e34f07u, 0xdaf5ccd93fb0cc53u,
+    0xe858ad248f5c22c9u, 0xd1b3400f8f9cff68u, 0x91376c36d99995beu, 0x23100809b9c21fa1u,
+    0xb58547448ffffb2du, 0xabd40a0c2832a78au, 0xe2e69915b3fff9f9u, 0x16c90c8f323f516cu,
+    0x8dd01fad907ffc3bu, 0xae3da7d97f6792e3u, 0xb1442798f49ffb4au, 0x99cd11cfdf41779cu,
+    0xdd95317f31c7fa1du, 0x40405643d711d583u, 0x8a7d3eef7f1cfc52u, 0x482835ea666b2572u,
+    0xad1c8eab5ee43b66u, 0xda3243650005eecfu, 0xd863b256369d4a40u, 0x90bed43e40076a82u,
+    0x873e4f75e2224e68u, 0x5a7744a6e804a291u, 0xa90de3535aaae202u, 0x711515d0a205cb36u,
+    0xd3515c2831559a83u, 0x0d5a5b44ca873e03u, 0x8412d9991ed58091u, 0xe858790afe9486c2u,
+    0xa5178fff668ae0b6u, 0x626e974dbe39a872u, 0xce5d73ff402d98e3u, 0xfb0a3d212dc8128fu,
+    0x80fa687f881c7f8eu, 0x7ce66634bc9d0b99u, 0xa139029f6a239f72u, 0x1c1fffc1ebc44e80u,
+    0xc987434744ac874eu, 0xa327ffb266b56220u, 0xfbe9141915d7a922u, 0x4bf1ff9f0062baa8u,
+    0x9d71ac8fada6c9b5u, 0x6f773fc3603db4a9u, 0xc4ce17b399107c22u, 0xcb550fb4384d21d3u,
+    0xf6019da07f549b2bu, 0x7e2a53a146606a48u, 0x99c102844f94e0fbu, 0x2eda7444cbfc426du,
+    0xc0314325637a1939u, 0xfa911155fefb5308u, 0xf03d93eebc589f88u, 0x793555ab7eba27cau,
+    0x96267c7535b763b5u, 0x4bc1558b2f3458deu, 0xbbb01b9283253ca2u, 0x9eb1aaedfb016f16u,
+    0xea9c227723ee8bcbu, 0x465e15a979c1cadcu, 0x92a1958a7675175fu, 0x0bfacd89ec191ec9u,
+    0xb749faed14125d36u, 0xcef980ec671f667bu, 0xe51c79a85916f484u, 0x82b7e12780e7401au,
+    0x8f31cc0937ae58d2u, 0xd1b2ecb8b0908810u, 0xb2fe3f0b8599ef07u, 0x861fa7e6dcb4aa15u,
+    0xdfbdcece67006ac9u, 0x67a791e093e1d49au, 0x8bd6a141006042bdu, 0xe0c8bb2c5c6d24e0u,
+    0xaecc49914078536du, 0x58fae9f773886e18u, 0xda7f5bf590966848u, 0xaf39a475506a899eu,
+    0x888f99797a5e012du, 0x6d8406c952429603u, 0xaab37fd7d8f58178u, 0xc8e5087ba6d33b83u,
+    0xd5605fcdcf32e1d6u, 0xfb1e4a9a90880a64u, 0x855c3be0a17fcd26u, 0x5cf2eea09a55067fu,
+    0xa6b34ad8c9dfc06fu, 0xf42faa48c0ea481eu, 0xd0601d8efc57b08bu, 0xf13b94daf124da26u,
+    0x823c12795db6ce57u, 0x76c53d08d6b70858u, 0xa2cb1717b52481edu, 0x54768c4b0c64ca6eu,
+    0xcb7ddcdda26da268u, 0xa9942f5dcf7dfd09u, 0xfe5d54150b090b02u, 0xd3f93b35435d7c4cu,
+    0x9efa548d26e5a6e1u, 0xc47bc5014a1a6dafu, 0xc6b8e9b0709f109au, 0x359ab6419ca1091bu,
+    0xf867241c8cc6d4c0u, 0xc30163d203c94b62u, 0x9b407691d7fc44f8u, 0x79e0de63425dcf1du,
+    0xc21094364dfb5636u, 0x985915fc12f542e4u, 0xf294b943e17a2bc4u, 0x3e6f5b7b17b2939du,
+    0x979cf3ca6cec5b5au, 0xa705992ceecf9c42u, 0xbd8430bd08277231u, 0x50c6ff782a838353u,
+    0xece53cec4a314ebdu, 0xa4f8bf5635246428u, 0x940f4613ae5ed136u, 0x871b7795e136be99u,
+    0xb913179899f68584u, 0x28e2557b59846e3fu, 0xe757dd7ec07426e5u, 0x331aeada2fe589cfu,
+    0x9096ea6f3848984fu, 0x3ff0d2c85def7621u, 0xb4bca50b065abe63u, 0x0fed077a756b53a9u,
+    0xe1ebce4dc7f16dfbu, 0xd3e8495912c62894u, 0x8d3360f09cf6e4bdu, 0x64712dd7abbbd95cu,
+    0xb080392cc4349decu, 0xbd8d794d96aacfb3u, 0xdca04777f541c567u, 0xecf0d7a0fc5583a0u,
+    0x89e42caaf9491b60u, 0xf41686c49db57244u, 0xac5d37d5b79b6239u, 0x311c2875c522ced5u,
+    0xd77485cb25823ac7u, 0x7d633293366b828bu, 0x86a8d39ef77164bcu, 0xae5dff9c02033197u,
+    0xa8530886b54dbdebu, 0xd9f57f830283fdfcu, 0xd267caa862a12d66u, 0xd072df63c324fd7bu,
+    0x8380dea93da4bc60u, 0x4247cb9e59f71e6du, 0xa46116538d0deb78u, 0x52d9be85f074e608u,
+    0xcd795be870516656u, 0x67902e276c921f8bu, 0x806bd9714632dff6u, 0x00ba1cd8a3db53b6u,
+    0xa086cfcd97bf97f3u, 0x80e8a40eccd228a4u, 0xc8a883c0fdaf7df0u, 0x6122cd128006b2cdu,
+    0xfad2a4b13d1b5d6cu, 0x796b805720085f81u, 0x9cc3a6eec6311a63u, 0xcbe3303674053bb0u,
+    0xc3f490aa77bd60fcu, 0xbedbfc4411068a9cu, 0xf4f1b4d515acb93bu, 0xee92fb5515482d44u,
+    0x991711052d8bf3c5u, 0x751bdd152d4d1c4au, 0xbf5cd54678eef0b6u, 0xd262d45a78a0635du,
+    0xef340a98172aace4u, 0x86fb897116c87c34u, 0x9580869f0e7aac0eu, 0xd45d35e6ae3d4da0u,
+    0xbae0a846d2195712u, 0x8974836059cca109u, 0xe998d258869facd7u, 0x2bd1a438703fc94bu,
+    0x91ff83775423cc06u, 0x7b6306a34627ddcfu, 0xb67f6455292cbf08u, 0x1a3bc84c17b1d542u,
+    0xe41f3d6a7377eecau, 0x20caba5f1d9e4a93u, 0x8e938662882af53eu, 0x547eb47b7282ee9cu,
+    0xb23867fb2a35b28du, 0xe99e619a4f23aa43u, 0xdec681f9f4c31f31u, 0x6405fa00e2ec94d4u,
+    0x8b3c113c38f9f37eu, 0xde83bc408dd3dd04u, 0xae0b158b4738705eu, 0x9624ab50b148d445u,
+    0xd98ddaee19068c76u, 0x3badd624dd9b0957u, 0x87f8a8d4cfa417c9u, 0xe54ca5d70a80e5d6u,
+    0xa9f6d30a038d1dbcu, 0x5e9fcf4ccd211f4cu, 0xd47487cc8470652bu, 0x7647c3200069671fu,
+    0x84c8d4dfd2c63f3bu, 0x29ecd9f40041e073u, 0xa5fb0a17c777cf09u, 0xf468107100525890u,
+    0xcf79cc9db955c2ccu, 0x7182148d4066eeb4u, 0x81ac1fe293d599bfu, 0xc6f14cd848405530u,
+    0xa21727db38cb002fu, 0xb8ada00e5a506a7cu, 0xca9cf1d206fdc03bu, 0xa6d90811f0e4851cu,
+    0xfd442e4688bd304au, 0x908f4a166d1da663u, 0x9e4a9cec15763e2eu, 0x9a598e4e043287feu,
+    0xc5dd44271ad3cdbau, 0x40eff1e1853f29fdu, 0xf7549530e188c128u, 0xd12bee59e68ef47cu,
+    0x9a94dd3e8cf578b9u, 0x82bb74f8301958ceu, 0xc13a148e3032d6e7u, 0xe36a52363c1faf01u,
+    0xf18899b1bc3f8ca1u, 0xdc44e6c3cb279ac1u, 0x96f5600f15a7b7e5u, 0x29ab103a5ef8c0b9u,
+    0xbcb2b812db11a5deu, 0x7415d448f6b6f0e7u, 0xebdf661791d60f56u, 0x111b495b3464ad21u,
+    0x936b9fcebb25c995u, 0xcab10dd900beec34u, 0xb84687c269ef3bfbu, 0x3d5d514f40eea742u,
+    0xe65829b3046b0afau, 0x0cb4a5a3112a5112u, 0x8ff71a0fe2c2e6dcu, 0x47f0e785eaba72abu,
+    0xb3f4e093db73a093u, 0x59ed216765690f56u, 0xe0f218b8d25088b8u, 0x306869c13ec3532cu,
+    0x8c974f7383725573u, 0x1e414218c73a13fbu, 0xafbd2350644eeacfu, 0xe5d1929ef90898fau,
+    0xdbac6c247d62a583u, 0xdf45f746b74abf39u, 0x894bc396ce5da772u, 0x6b8bba8c328eb783u,
+    0xab9eb47c81f5114fu, 0x066ea92f3f326564u, 0xd686619ba27255a2u, 0xc80a537b0efefebdu,
+    0x8613fd0145877585u, 0xbd06742ce95f5f36u, 0xa798fc4196e952e7u, 0x2c48113823b73704u,
+    0xd17f3b51fca3a7a0u, 0xf75a15862ca504c5u, 0x82ef85133de648c4u, 0x9a984d73dbe722fbu,
+    0xa3ab66580d5fdaf5u, 0xc13e60d0d2e0ebbau, 0xcc963fee10b7d1b3u, 0x318df905079926a8u,
+    0xffbbcfe994e5c61fu, 0xfdf17746497f7052u, 0x9fd561f1fd0f9bd3u, 0xfeb6ea8bedefa633u,
+    0xc7caba6e7c5382c8u, 0xfe64a52ee96b8fc0u, 0xf9bd690a1b68637bu, 0x3dfdce7aa3c673b0u,
+    0x9c1661a651213e2du, 0x06bea10ca65c084eu, 0xc31bfa0fe5698db8u, 0x486e494fcff30a62u,
+    0xf3e2f893dec3f126u, 0x5a89dba3c3efccfau, 0x986ddb5c6b3a76b7u, 0xf89629465a75e01cu,
+    0xbe89523386091465u, 0xf6bbb397f1135823u, 0xee2ba6c0678b597fu, 0x746aa07ded582e2cu,
+    0x94db483840b717efu, 0xa8c2a44eb4571cdcu, 0xba121a4650e4ddebu, 0x92f34d62616ce413u,
+    0xe896a0d7e51e1566u, 0x77b020baf9c81d17u, 0x915e2486ef32cd60u, 0x0ace1474dc1d122eu,
+    0xb5b5ada8aaff80b8u, 0x0d819992132456bau, 0xe3231912d5bf60e6u, 0x10e1fff697ed6c69u,
+    0x8df5efabc5979c8fu, 0xca8d3ffa1ef463c1u, 0xb1736b96b6fd83b3u, 0xbd308ff8a6b17cb2u,
+    0xddd0467c64bce4a0u, 0xac7cb3f6d05ddbdeu, 0x8aa22c0dbef60ee4u, 0x6bcdf07a423aa96bu,
+    0xad4ab7112eb3929du, 0x86c16c98d2c953c6u, 0xd89d64d57a607744u, 0xe871c7bf077ba8b7u,
+    0x87625f056c7c4a8bu, 0x11471cd764ad4972u, 0xa93af6c6c79b5d2du, 0xd598e40d3dd89bcfu,
+    0xd389b47879823479u, 0x4aff1d108d4ec2c3u, 0x843610cb4bf160cbu, 0xcedf722a585139bau,
+    0xa54394fe1eedb8feu, 0xc2974eb4ee658828u, 0xce947a3da6a9273eu, 0x733d226229feea32u,
+    0x811ccc668829b887u, 0x0806357d5a3f525fu, 0xa163ff802a3426a8u, 0xca07c2dcb0cf26f7u,
+    0xc9bcff6034c13052u, 0xfc89b393dd02f0b5u, 0xfc2c3f3841f17c67u, 0xbbac2078d443ace2u,
+    0x9d9ba7832936edc0u, 0xd54b944b84aa4c0du, 0xc5029163f384a931u, 0x0a9e795e65d4df11u,
+    0xf64335bcf065d37du, 0x4d4617b5ff4a16d5u, 0x99ea0196163fa42eu, 0x504bced1bf8e4e45u,
+    0xc06481fb9bcf8d39u, 0xe45ec2862f71e1d6u, 0xf07da27a82c37088u, 0x5d767327bb4e5a4cu,
+    0x964e858c91ba2655u, 0x3a6a07f8d510f86fu, 0xbbe226efb628afeau, 0x890489f70a55368bu,
+    0xeadab0aba3b2dbe5u, 0x2b45ac74ccea842eu, 0x92c8ae6b464fc96fu, 0x3b0b8bc90012929du,
+    0xb77ada0617e3bbcbu, 0x09ce6ebb40173744u, 0xe55990879ddcaabdu, 0xcc420a6a101d0515u,
+    0x8f57fa54c2a9eab6u, 0x9fa946824a12232du, 0xb32df8e9f3546564u, 0x47939822dc96abf9u,
+    0xdff9772470297ebdu, 0x59787e2b93bc56f7u, 0x8bfbea76c619ef36u, 0x57eb4edb3c55b65au,
+    0xaefae51477a06b03u, 0xede622920b6b23f1u, 0xdab99e59958885c4u, 0xe95fab368e45ecedu,
+    0x88b402f7fd75539bu, 0x11dbcb0218ebb414u, 0xaae103b5fcd2a881u, 0xd652bdc29f26a119u,
+    0xd59944a37c0752a2u, 0x4be76d3346f0495fu, 0x857fcae62d8493a5u, 0x6f70a4400c562ddbu,
+    0xa6dfbd9fb8e5b88eu, 0xcb4ccd500f6bb952u, 0xd097ad07a71f26b2u, 0x7e2000a41346a7a7u,
+    0x825ecc24c873782fu, 0x8ed400668c0c28c8u, 0xa2f67f2dfa90563bu, 0x728900802f0f32fau,
+    0xcbb41ef979346bcau, 0x4f2b40a03ad2ffb9u, 0xfea126b7d78186bcu, 0xe2f610c84987bfa8u,
+    0x9f24b832e6b0f436u, 0x0dd9ca7d2df4d7c9u, 0xc6ede63fa05d3143u, 0x91503d1c79720dbbu,
+    0xf8a95fcf88747d94u, 0x75a44c6397ce912au, 0x9b69dbe1b548ce7cu, 0xc986afbe3ee11abau,
+    0xc24452da229b021bu, 0xfbe85badce996168u, 0xf2d56790ab41c2a2u, 0xfae27299423fb9c3u,
+    0x97c560ba6b0919a5u, 0xdccd879fc967d41au, 0xbdb6b8e905cb600fu, 0x5400e987bbc1c920u,
+    0xed246723473e3813u, 0x290123e9aab23b68u, 0x9436c0760c86e30bu, 0xf9a0b6720aaf6521u,
+    0xb94470938fa89bceu, 0xf808e40e8d5b3e69u, 0xe7958cb87392c2c2u, 0xb60b1d1230b20e04u,
+    0x90bd77f3483bb9b9u, 0xb1c6f22b5e6f48c2u, 0xb4ecd5f01a4aa828u, 0x1e38aeb6360b1af3u,
+    0xe2280b6c20dd5232u, 0x25c6da63c38de1b0u, 0x8d590723948a535fu, 0x579c487e5a38ad0eu,
+    0xb0af48ec79ace837u, 0x2d835a9df0c6d851u, 0xdcdb1b2798182244u, 0xf8e431456cf88e65u,
+    0x8a08f0f8bf0f156bu, 0x1b8e9ecb641b58ffu, 0xac8b2d36eed2dac5u, 0xe272467e3d222f3fu,
+    0xd7adf884aa879177u, 0x5b0ed81dcc6abb0fu, 0x86ccbb52ea94baeau, 0x98e947129fc2b4e9u,
+    0xa87fea27a539e9a5u, 0x3f2398d747b36224u, 0xd29fe4b18e88640eu, 0x8eec7f0d19a03aadu,
+    0x83a3eeeef9153e89u, 0x1953cf68300424acu, 0xa48ceaaab75a8e2bu, 0x5fa8c3423c052dd7u,
+    0xcdb02555653131b6u, 0x3792f412cb06794du, 0x808e17555f3ebf11u, 0xe2bbd88bbee40bd0u,
+    0xa0b19d2ab70e6ed6u, 0x5b6aceaeae9d0ec4u, 0xc8de047564d20a8bu, 0xf245825a5a445275u,
+    0xfb158592be068d2eu, 0xeed6e2f0f0d56712u, 0x9ced737bb6c4183du, 0x55464dd69685606bu,
+    0xc428d05aa4751e4cu, 0xaa97e14c3c26b886u, 0xf53304714d9265dfu, 0xd53dd99f4b3066a8u,
+    0x993fe2c6d07b7fabu, 0xe546a8038efe4029u, 0xbf8fdb78849a5f96u, 0xde98520472bdd033u,
+    0xef73d256a5c0f77cu, 0x963e66858f6d4440u, 0x95a8637627989aadu, 0xdde7001379a44aa8u,
+    0xbb127c53b17ec159u, 0x5560c018580d5d52u, 0xe9d71b689dde71afu, 0xaab8f01e6e10b4a6u,
+    0x9226712162ab070du, 0xcab3961304ca70e8u, 0xb6b00d69bb55c8d1u, 0x3d607b97c5fd0d22u,
+    0xe45c10c42a2b3b05u, 0x8cb89a7db77c506au, 0x8eb98a7a9a5b04e3u, 0x77f3608e92adb242u,
+    0xb267ed1940f1c61cu, 0x55f038b237591ed3u, 0xdf01e85f912e37a3u, 0x6b6c46dec52f6688u,
+    0x8b61313bbabce2c6u, 0x2323ac4b3b3da015u, 0xae397d8aa96c1b77u, 0xabec975e0a0d081au,
+    0xd9c7dced53c72255u, 0x96e7bd358c904a21u, 0x881cea14545c7575u, 0x7e50d64177da2e54u,
+    0xaa242499697392d2u, 0xdde50bd1d5d0b9e9u, 0xd4ad2dbfc3d07787u, 0x955e4ec64b44e864u,
+    0x84ec3c97da624ab4u, 0xbd5af13bef0b113eu, 0xa6274bbdd0fadd61u, 0xecb1ad8aeacdd58eu,
+    0xcfb11ead453994bau, 0x67de18eda5814af2u, 0x81ceb32c4b43fcf4u, 0x80eacf948770ced7u,
+    0xa2425ff75e14fc31u, 0xa1258379a94d028du, 0xcad2f7f5359a3b3eu, 0x096ee45813a04330u,
+    0xfd87b5f28300ca0du, 0x8bca9d6e188853fcu, 0x9e74d1b791e07e48u, 0x775ea264cf55347eu,
+    0xc612062576589ddau, 0x95364afe032a819eu, 0xf79687aed3eec551u, 0x3a83ddbd83f52205u,
+    0x9abe14cd44753b52u, 0xc4926a9672793543u, 0xc16d9a0095928a27u, 0x75b7053c0f178294u,
+    0xf1c90080baf72cb1u, 0x5324c68b12dd6339u, 0x971da05074da7beeu, 0xd3f6fc16ebca5e04u,
+    0xbce5086492111aeau, 0x88f4bb1ca6bcf585u, 0xec1e4a7db69561a5u, 0x2b31e9e3d06c32e6u,
+    0x9392ee8e921d5d07u, 0x3aff322e62439fd0u, 0xb877aa3236a4b449u, 0x09befeb9fad487c3u,
+    0xe69594bec44de15bu, 0x4c2ebe687989a9b4u, 0x901d7cf73ab0acd9u, 0x0f9d37014bf60a11u,
+    0xb424dc35095cd80fu, 0x538484c19ef38c95u, 0xe12e13424bb40e13u, 0x2865a5f206b06fbau,
+    0x8cbccc096f5088cbu, 0xf93f87b7442e45d4u, 0xafebff0bcb24aafeu, 0xf78f69a51539d749u,
+    0xdbe6fecebdedd5beu, 0xb573440e5a884d1cu, 0x89705f4136b4a597u, 0x31680a88f8953031u,
+    0xabcc77118461cefcu, 0xfdc20d2b36ba7c3eu, 0xd6bf94d5e57a42bcu, 0x3d32907604691b4du,
+    0x8637bd05af6c69b5u, 0xa63f9a49c2c1b110u, 0xa7c5ac471b478423u, 0x0fcf80dc33721d54u,
+    0xd1b71758e219652bu, 0xd3c36113404ea4a9u, 0x83126e978d4fdf3bu, 0x645a1cac083126eau,
+    0xa3d70a3d70a3d70au, 0x3d70a3d70a3d70a4u, 0xccccccccccccccccu, 0xcccccccccccccccdu,
+    0x8000000000000000u, 0x0000000000000000u, 0xa000000000000000u, 0x0000000000000000u,
+    0xc800000000000000u, 0x0000000000000000u, 0xfa00000000000000u, 0x0000000000000000u,
+    0x9c40000000000000u, 0x0000000000000000u, 0xc350000000000000u, 0x0000000000000000u,
+    0xf424000000000000u, 0x0000000000000000u, 0x9896800000000000u, 0x0000000000000000u,
+    0xbebc200000000000u, 0x0000000000000000u, 0xee6b280000000000u, 0x0000000000000000u,
+    0x9502f90000000000u, 0x0000000000000000u, 0xba43b74000000000u, 0x0000000000000000u,
+    0xe8d4a51000000000u, 0x0000000000000000u, 0x9184e72a00000000u, 0x0000000000000000u,
+    0xb5e620f480000000u, 0x0000000000000000u, 0xe35fa931a0000000u, 0x0000000000000000u,
+    0x8e1bc9bf04000000u, 0x0000000000000000u, 0xb1a2bc2ec5000000u, 0x0000000000000000u,
+    0xde0b6b3a76400000u, 0x0000000000000000u, 0x8ac7230489e80000u, 0x0000000000000000u,
+    0xad78ebc5ac620000u, 0x0000000000000000u, 0xd8d726b7177a8000u, 0x0000000000000000u,
+    0x878678326eac9000u, 0x0000000000000000u, 0xa968163f0a57b400u, 0x0000000000000000u,
+    0xd3c21bcecceda100u, 0x0000000000000000u, 0x84595161401484a0u, 0x0000000000000000u,
+    0xa56fa5b99019a5c8u, 0x0000000000000000u, 0xcecb8f27f4200f3au, 0x0000000000000000u,
+    0x813f3978f8940984u, 0x4000000000000000u, 0xa18f07d736b90be5u, 0x5000000000000000u,
+    0xc9f2c9cd04674edeu, 0xa400000000000000u, 0xfc6f7c4045812296u, 0x4d00000000000000u,
+    0x9dc5ada82b70b59du, 0xf020000000000000u, 0xc5371912364ce305u, 0x6c28000000000000u,
+    0xf684df56c3e01bc6u, 0xc732000000000000u, 0x9a130b963a6c115cu, 0x3c7f400000000000u,
+    0xc097ce7bc90715b3u, 0x4b9f100000000000u, 0xf0bdc21abb48db20u, 0x1e86d40000000000u,
+    0x96769950b50d88f4u, 0x1314448000000000u, 0xbc143fa4e250eb31u, 0x17d955a000000000u,
+    0xeb194f8e1ae525fdu, 0x5dcfab0800000000u, 0x92efd1b8d0cf37beu, 0x5aa1cae500000000u,
+    0xb7abc627050305adu, 0xf14a3d9e40000000u, 0xe596b7b0c643c719u, 0x6d9ccd05d0000000u,
+    0x8f7e32ce7bea5c6fu, 0xe4820023a2000000u, 0xb35dbf821ae4f38bu, 0xdda2802c8a800000u,
+    0xe0352f62a19e306eu, 0xd50b2037ad200000u, 0x8c213d9da502de45u, 0x4526f422cc340000u,
+    0xaf298d050e4395d6u, 0x9670b12b7f410000u, 0xdaf3f04651d47b4cu, 0x3c0cdd765f114000u,
+    0x88d8762bf324cd0fu, 0xa5880a69fb6ac800u, 0xab0e93b6efee0053u, 0x8eea0d047a457a00u,
+    0xd5d238a4abe98068u, 0x72a4904598d6d880u, 0x85a36366eb71f041u, 0x47a6da2b7f864750u,
+    0xa70c3c40a64e6c51u, 0x999090b65f67d924u, 0xd0cf4b50cfe20765u, 0xfff4b4e3f741cf6du,
+    0x82818f1281ed449fu, 0xbff8f10e7a8921a4u, 0xa321f2d7226895c7u, 0xaff72d52192b6a0du,
+    0xcbea6f8ceb02bb39u, 0x9bf4f8a69f764490u, 0xfee50b7025c36a08u, 0x02f236d04753d5b4u,
+    0x9f4f2726179a2245u, 0x01d762422c946590u, 0xc722f0ef9d80aad6u, 0x424d3ad2b7b97ef5u,
+    0xf8ebad2b84e0d58bu, 0xd2e0898765a7deb2u, 0x9b934c3b330c8577u, 0x63cc55f49f88eb2fu,
+    0xc2781f49ffcfa6d5u, 0x3cbf6b71c76b25fbu, 0xf316271c7fc3908au, 0x8bef464e3945ef7au,
+    0x97edd871cfda3a56u, 0x97758bf0e3cbb5acu, 0xbde94e8e43d0c8ecu, 0x3d52eeed1cbea317u,
+    0xed63a231d4c4fb27u, 0x4ca7aaa863ee4bddu, 0x945e455f24fb1cf8u, 0x8fe8caa93e74ef6au,
+    0xb975d6b6ee39e436u, 0xb3e2fd538e122b44u, 0xe7d34c64a9c85d44u, 0x60dbbca87196b616u,
+    0x90e40fbeea1d3a4au, 0xbc8955e946fe31cdu, 0xb51d13aea4a488ddu, 0x6babab6398bdbe41u,
+    0xe264589a4dcdab14u, 0xc696963c7eed2dd1u, 0x8d7eb76070a08aecu, 0xfc1e1de5cf543ca2u,
+    0xb0de65388cc8ada8u, 0x3b25a55f43294bcbu, 0xdd15fe86affad912u, 0x49ef0eb713f39ebeu,
+    0x8a2dbf142dfcc7abu, 0x6e3569326c784337u, 0xacb92ed9397bf996u, 0x49c2c37f07965404u,
+    0xd7e77a8f87daf7fbu, 0xdc33745ec97be906u, 0x86f0ac99b4e8dafdu, 0x69a028bb3ded71a3u,
+    0xa8acd7c0222311bcu, 0xc40832ea0d68ce0cu, 0xd2d80db02aabd62bu, 0xf50a3fa490c30190u,
+    0x83c7088e1aab65dbu, 0x792667c6da79e0fau, 0xa4b8cab1a1563f52u, 0x577001b891185938u,
+    0xcde6fd5e09abcf26u, 0xed4c0226b55e6f86u, 0x80b05e5ac60b6178u, 0x544f8158315b05b4u,
+    0xa0dc75f1778e39d6u, 0x696361ae3db1c721u, 0xc913936dd571c84cu, 0x03bc3a19cd1e38e9u,
+    0xfb5878494ace3a5fu, 0x04ab48a04065c723u, 0x9d174b2dcec0e47bu, 0x62eb0d64283f9c76u,
+    0xc45d1df942711d9au, 0x3ba5d0bd324f8394u, 0xf5746577930d6500u, 0xca8f44ec7ee36479u,
+    0x9968bf6abbe85f20u, 0x7e998b13cf4e1ecbu, 0xbfc2ef456ae276e8u, 0x9e3fedd8c321a67eu,
+    0xefb3ab16c59b14a2u, 0xc5cfe94ef3ea101eu, 0x95d04aee3b80ece5u, 0xbba1f1d158724a12u,
+    0xbb445da9ca61281fu, 0x2a8a6e45ae8edc97u, 0xea1575143cf97226u, 0xf52d09d71a3293bdu,
+    0x924d692ca61be758u, 0x593c2626705f9c56u, 0xb6e0c377cfa2e12eu, 0x6f8b2fb00c77836cu,
+    0xe498f455c38b997au, 0x0b6dfb9c0f956447u, 0x8edf98b59a373fecu, 0x4724bd4189bd5eacu,
+    0xb2977ee300c50fe7u, 0x58edec91ec2cb657u, 0xdf3d5e9bc0f653e1u, 0x2f2967b66737e3edu,
+    0x8b865b215899f46cu, 0xbd79e0d20082ee74u, 0xae67f1e9aec07187u, 0xecd8590680a3aa11u,
+    0xda01ee641a708de9u, 0xe80e6f4820cc9495u, 0x884134fe908658b2u, 0x3109058d147fdcddu,
+    0xaa51823e34a7eedeu, 0xbd4b46f0599fd415u, 0xd4e5e2cdc1d1ea96u, 0x6c9e18ac7007c91au,
+    0x850fadc09923329eu, 0x03e2cf6bc604ddb0u, 0xa6539930bf6bff45u, 0x84db8346b786151cu,
+    0xcfe87f7cef46ff16u, 0xe612641865679a63u, 0x81f14fae158c5f6eu, 0x4fcb7e8f3f60c07eu,
+    0xa26da3999aef7749u, 0xe3be5e330f38f09du, 0xcb090c8001ab551cu, 0x5cadf5bfd3072cc5u,
+    0xfdcb4fa002162a63u, 0x73d9732fc7c8f7f6u, 0x9e9f11c4014dda7eu, 0x2867e7fddcdd9afau,
+    0xc646d63501a1511du, 0xb281e1fd541501b8u, 0xf7d88bc24209a565u, 0x1f225a7ca91a4226u,
+    0x9ae757596946075fu, 0x3375788de9b06958u, 0xc1a12d2fc3978937u, 0x0052d6b1641c83aeu,
+    0xf209787bb47d6b84u, 0xc0678c5dbd23a49au, 0x9745eb4d50ce6332u, 0xf840b7ba963646e0u,
+    0xbd176620a501fbffu, 0xb650e5a93bc3d898u, 0xec5d3fa8ce427affu, 0xa3e51f138ab4cebeu,
+    0x93ba47c980e98cdfu, 0xc66f336c36b10137u, 0xb8a8d9bbe123f017u, 0xb80b0047445d4184u,
+    0xe6d3102ad96cec1du, 0xa60dc059157491e5u, 0x9043ea1ac7e41392u, 0x87c89837ad68db2fu,
+    0xb454e4a179dd1877u, 0x29babe4598c311fbu, 0xe16a1dc9d8545e94u, 0xf4296dd6fef3d67au,
+    0x8ce2529e2734bb1du, 0x1899e4a65f58660cu, 0xb01ae745b101e9e4u, 0x5ec05dcff72e7f8fu,
+    0xdc21a1171d42645du, 0x76707543f4fa1f73u, 0x899504ae72497ebau, 0x6a06494a791c53a8u,
+    0xabfa45da0edbde69u, 0x0487db9d17636892u, 0xd6f8d7509292d603u, 0x45a9d2845d3c42b6u,
+    0x865b86925b9bc5c2u, 0x0b8a2392ba45a9b2u, 0xa7f26836f282b732u, 0x8e6cac7768d7141eu,
+    0xd1ef0244af2364ffu, 0x3207d795430cd926u, 0x8335616aed761f1fu, 0x7f44e6bd49e807b8u,
+    0xa402b9c5a8d3a6e7u, 0x5f16206c9c6209a6u, 0xcd036837130890a1u, 0x36dba887c37a8c0fu,
+    0x802221226be55a64u, 0xc2494954da2c9789u, 0xa02aa96b06deb0fdu, 0xf2db9baa10b7bd6cu,
+    0xc83553c5c8965d3du, 0x6f92829494e5acc7u, 0xfa42a8b73abbf48cu, 0xcb772339ba1f17f9u,
+    0x9c69a97284b578d7u, 0xff2a760414536efbu, 0xc38413cf25e2d70du, 0xfef5138519684abau,
+    0xf46518c2ef5b8cd1u, 0x7eb258665fc25d69u, 0x98bf2f79d5993802u, 0xef2f773ffbd97a61u,
+    0xbeeefb584aff8603u, 0xaafb550ffacfd8fau, 0xeeaaba2e5dbf6784u, 0x95ba2a53f983cf38u,
+    0x952ab45cfa97a0b2u, 0xdd945a747bf26183u, 0xba756174393d88dfu, 0x94f971119aeef9e4u,
+    0xe912b9d1478ceb17u, 0x7a37cd5601aab85du, 0x91abb422ccb812eeu, 0xac62e055c10ab33au,
+    0xb616a12b7fe617aau, 0x577b986b314d6009u, 0xe39c49765fdf9d94u, 0xed5a7e85fda0b80bu,
+    0x8e41ade9fbebc27du, 0x14588f13be847307u, 0xb1d219647ae6b31cu, 0x596eb2d8ae258fc8u,
+    0xde469fbd99a05fe3u, 0x6fca5f8ed9aef3bbu, 0x8aec23d680043beeu, 0x25de7bb9480d5854u,
+    0xada72ccc20054ae9u, 0xaf561aa79a10ae6au, 0xd910f7ff28069da4u, 0x1b2ba1518094da04u,
+    0x87aa9aff79042286u, 0x90fb44d2f05d0842u, 0xa99541bf57452b28u, 0x353a1607ac744a53u,
+    0xd3fa922f2d1675f2u, 0x42889b8997915ce8u, 0x847c9b5d7c2e09b7u, 0x69956135febada11u,
+    0xa59bc234db398c25u, 0x43fab9837e699095u, 0xcf02b2c21207ef2eu, 0x94f967e45e03f4bbu,
+    0x8161afb94b44f57du, 0x1d1be0eebac278f5u, 0xa1ba1ba79e1632dcu, 0x6462d92a69731732u,
+    0xca28a291859bbf93u, 0x7d7b8f7503cfdcfeu, 0xfcb2cb35e702af78u, 0x5cda735244c3d43eu,
+    0x9defbf01b061adabu, 0x3a0888136afa64a7u, 0xc56baec21c7a1916u, 0x088aaa1845b8fdd0u,
+    0xf6c69a72a3989f5bu, 0x8aad549e57273d45u, 0x9a3c2087a63f6399u, 0x36ac54e2f678864bu,
+    0xc0cb28a98fcf3c7fu, 0x84576a1bb416a7ddu, 0xf0fdf2d3f3c30b9fu, 0x656d44a2a11c51d5u,
+    0x969eb7c47859e743u, 0x9f644ae5a4b1b325u, 0xbc4665b596706114u, 0x873d5d9f0dde1feeu,
+    0xeb57ff22fc0c7959u, 0xa90cb506d155a7eau, 0x9316ff75dd87cbd8u, 0x09a7f12442d588f2u,
+    0xb7dcbf5354e9beceu, 0x0c11ed6d538aeb2fu, 0xe5d3ef282a242e81u, 0x8f1668c8a86da5fau,
+    0x8fa475791a569d10u, 0xf96e017d694487bcu, 0xb38d92d760ec4455u, 0x37c981dcc395a9acu,
+    0xe070f78d3927556au, 0x85bbe253f47b1417u, 0x8c469ab843b89562u, 0x93956d7478ccec8eu,
+    0xaf58416654a6babbu, 0x387ac8d1970027b2u, 0xdb2e51bfe9d0696au, 0x06997b05fcc0319eu,
+    0x88fcf317f22241e2u, 0x441fece3bdf81f03u, 0xab3c2fddeeaad25au, 0xd527e81cad7626c3u,
+    0xd60b3bd56a5586f1u, 0x8a71e223d8d3b074u, 0x85c7056562757456u, 0xf6872d5667844e49u,
+    0xa738c6bebb12d16cu, 0xb428f8ac016561dbu, 0xd106f86e69d785c7u, 0xe13336d701beba52u,
+    0x82a45b450226b39cu, 0xecc0024661173473u, 0xa34d721642b06084u, 0x27f002d7f95d0190u,
+    0xcc20ce9bd35c78a5u, 0x31ec038df7b441f4u, 0xff290242c83396ceu, 0x7e67047175a15271u,
+    0x9f79a169bd203e41u, 0x0f0062c6e984d386u, 0xc75809c42c684dd1u, 0x52c07b78a3e60868u,
+    0xf92e0c3537826145u, 0xa7709a56ccdf8a82u, 0x9bbcc7a142b17ccbu, 0x88a66076400bb691u,
+    0xc2abf989935ddbfeu, 0x6acff893d00ea435u, 0xf356f7ebf83552feu, 0x0583f6b8c4124d43u,
+    0x98165af37b2153deu, 0xc3727a337a8b704au, 0xbe1bf1b059e9a8d6u, 0x744f18c0592e4c5cu,
+    0xeda2ee1c7064130cu, 0x1162def06f79df73u, 0x9485d4d1c63e8be7u, 0x8addcb5645ac2ba8u,
+    0xb9a74a0637ce2ee1u, 0x6d953e2bd7173692u, 0xe8111c87c5c1ba99u, 0xc8fa8db6ccdd0437u,
+    0x910ab1d4db9914a0u, 0x1d9c9892400a22a2u, 0xb54d5e4a127f59c8u, 0x2503beb6d00cab4bu,
+    0xe2a0b5dc971f303au, 0x2e44ae64840fd61du, 0x8da471a9de737e24u, 0x5ceaecfed289e5d2u,
+    0xb10d8e1456105dadu, 0x7425a83e872c5f47u, 0xdd50f1996b947518u, 0xd12f124e28f77719u,
+    0x8a5296ffe33cc92fu, 0x82bd6b70d99aaa6fu, 0xace73cbfdc0bfb7bu, 0x636cc64d1001550bu,
+    0xd8210befd30efa5au, 0x3c47f7e05401aa4eu, 0x8714a775e3e95c78u, 0x65acfaec34810a71u,
+    0xa8d9d1535ce3b396u, 0x7f1839a741a14d0du, 0xd31045a8341ca07cu, 0x1ede48111209a050u,
+    0x83ea2b892091e44du, 0x934aed0aab460432u, 0xa4e4b66b68b65d60u, 0xf81da84d5617853fu,
+    0xce1de40642e3f4b9u, 0x36251260ab9d668eu, 0x80d2ae83e9ce78f3u, 0xc1d72b7c6b426019u,
+    0xa1075a24e4421730u, 0xb24cf65b8612f81fu, 0xc94930ae1d529cfcu, 0xdee033f26797b627u,
+    0xfb9b7cd9a4a7443cu, 0x169840ef017da3b1u, 0x9d412e0806e88aa5u, 0x8e1f289560ee864eu,
+    0xc491798a08a2ad4eu, 0xf1a6f2bab92a27e2u, 0xf5b5d7ec8acb58a2u, 0xae10af696774b1dbu,
+    0x9991a6f3d6bf1765u, 0xacca6da1e0a8ef29u, 0xbff610b0cc6edd3fu, 0x17fd090a58d32af3u,
+    0xeff394dcff8a948eu, 0xddfc4b4cef07f5b0u, 0x95f83d0a1fb69cd9u, 0x4abdaf101564f98eu,
+    0xbb764c4ca7a4440fu, 0x9d6d1ad41abe37f1u, 0xea53df5fd18d5513u, 0x84c86189216dc5edu,
+    0x92746b9be2f8552cu, 0x32fd3cf5b4e49bb4u, 0xb7118682dbb66a77u, 0x3fbc8c33221dc2a1u,
+    0xe4d5e82392a40515u, 0x0fabaf3feaa5334au, 0x8f05b1163ba6832du, 0x29cb4d87f2a7400eu,
+    0xb2c71d5bca9023f8u, 0x743e20e9ef511012u, 0xdf78e4b2bd342cf6u, 0x914da9246b255416u,
+    0x8bab8eefb6409c1au, 0x1ad089b6c2f7548eu, 0xae9672aba3d0c320u, 0xa184ac2473b529b1u,
+    0xda3c0f568cc4f3e8u, 0xc9e5d72d90a2741eu, 0x8865899617fb1871u, 0x7e2fa67c7a658892u,
+    0xaa7eebfb9df9de8du, 0xddbb901b98feeab7u, 0xd51ea6fa85785631u, 0x552a74227f3ea565u,
+    0x8533285c936b35deu, 0xd53a88958f87275fu, 0xa67ff273b8460356u, 0x8a892abaf368f137u,
+    0xd01fef10a657842cu, 0x2d2b7569b0432d85u, 0x8213f56a67f6b29bu, 0x9c3b29620e29fc73u,
+    0xa298f2c501f45f42u, 0x8349f3ba91b47b8fu, 0xcb3f2f7642717713u, 0x241c70a936219a73u,
+    0xfe0efb53d30dd4d7u, 0xed238cd383aa0110u, 0x9ec95d1463e8a506u, 0xf4363804324a40aau,
+    0xc67bb4597ce2ce48u, 0xb143c6053edcd0d5u, 0xf81aa16fdc1b81dau, 0xdd94b7868e94050au,
+    0x9b10a4e5e9913128u, 0xca7cf2b4191c8326u, 0xc1d4ce1f63f57d72u, 0xfd1c2f611f63a3f0u,
+    0xf24a01a73cf2dccfu, 0xbc633b39673c8cecu, 0x976e41088617ca01u, 0xd5be0503e085d813u,
+    0xbd49d14aa79dbc82u, 0x4b2d8644d8a74e18u, 0xec9c459d51852ba2u, 0xddf8e7d60ed1219eu,
+    0x93e1ab8252f33b45u, 0xcabb90e5c942b503u, 0xb8da1662e7b00a17u, 0x3d6a751f3b936243u,
+    0xe7109bfba19c0c9du, 0x0cc512670a783ad4u, 0x906a617d450187e2u, 0x27fb2b80668b24c5u,
+    0xb484f9dc9641e9dau, 0xb1f9f660802dedf6u, 0xe1a63853bbd26451u, 0x5e7873f8a0396973u,
+    0x8d07e33455637eb2u, 0xdb0b487b6423e1e8u, 0xb049dc016abc5e5fu, 0x91ce1a9a3d2cda62u,
+    0xdc5c5301c56b75f7u, 0x7641a140cc7810fbu, 0x89b9b3e11b6329bau, 0xa9e904c87fcb0a9du,
+    0xac2820d9623bf429u, 0x546345fa9fbdcd44u, 0xd732290fbacaf133u, 0xa97c177947ad4095u,
+    0x867f59a9d4bed6c0u, 0x49ed8eabcccc485du, 0xa81f301449ee8c70u, 0x5c68f256bfff5a74u,
+    0xd226fc195c6a2f8cu, 0x73832eec6fff3111u, 0x83585d8fd9c25db7u, 0xc831fd53c5ff7eabu,
+    0xa42e74f3d032f525u, 0xba3e7ca8b77f5e55u, 0xcd3a1230c43fb26fu, 0x28ce1bd2e55f35ebu,
+    0x80444b5e7aa7cf85u, 0x7980d163cf5b81b3u, 0xa0555e361951c366u, 0xd7e105bcc332621fu,
+    0xc86ab5c39fa63440u, 0x8dd9472bf3fefaa7u, 0xfa856334878fc150u, 0xb14f98f6f0feb951u,
+    0x9c935e00d4b9d8d2u, 0x6ed1bf9a569f33d3u, 0xc3b8358109e84f07u, 0x0a862f80ec4700c8u,
+    0xf4a642e14c6262c8u, 0xcd27bb612758c0fau, 0x98e7e9cccfbd7dbdu, 0x8038d51cb897789cu,
+    0xbf21e44003acdd2cu, 0xe0470a63e6bd56c3u, 0xeeea5d5004981478u, 0x1858ccfce06cac74u,
+    0x95527a5202df0ccbu, 0x0f37801e0c43ebc8u, 0xbaa718e68396cffdu, 0xd30560258f54e6bau,
+    0xe950df20247c83fdu, 0x47c6b82ef32a2069u, 0x91d28b7416cdd27eu, 0x4cdc331d57fa5441u,
+    0xb6472e511c81471du, 0xe0133fe4adf8e952u, 0xe3d8f9e563a198e5u, 0x58180fddd97723a6u,
+    0x8e679c2f5e44ff8fu, 0x570f09eaa7ea7648u
+};
+
+/* a decimal number w * 10^q as written in the text */
+struct PlyDecimal
+{
+    U64 mantissa;
+    I64 exponent;
+    bool negative;
+    bool tooManyDigits; /* the mantissa was truncated to 19 digits */
+    U64 length;
+};
+
+/* the parameters of an IEEE 754 binary format needed by computeBinaryFloat */
+struct PlyBinaryFormat
+{
+    I32 mantissaExplicitBits;
+    I32 minimumExponent;
+    I32 infinitePower;
+    I32 minExponentRoundToEven;
+    I32 maxExponentRoundToEven;
+    I32 smallestPowerOfTen;
+    I32 largestPowerOfTen;
+    I32 signIndex;
+};
+
+static const struct PlyBinaryFormat plyBinary64Format = { 52, -1023, 0x7FF, -4, 23, -342, 308, 63 };
+static const struct PlyBinaryFormat plyBinary32Format = { 23, -127, 0xFF, -17, 10, -64, 38, 31 };
+
+PLY_INLINE U64 plyMul128(const U64 a, const U64 b, U64* highOut)
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = (unsigned __int128)a * b;
+    *highOut = (U64)(r >> 64);
+    return (U64)r;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, highOut);
+#else
+    const U64 aLo = (U32)a, aHi = a >> 32, bLo = (U32)b, bHi = b >> 32;
+    const U64 lolo = aLo * bLo, hilo = aHi * bLo, lohi = aLo * bHi, hihi = aHi * bHi;
+    const U64 cross = (lolo >> 32) + (U32)hilo + lohi;
+    *highOut = hihi + (hilo >> 32) + (cross >> 32);
+    return (cross << 32) | (U32)lolo;
+#endif
+}
+
+/* number of leading zero bits, x must not be 0 */
+PLY_INLINE U32 plyClz64(const U64 x)
+{
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanReverse64(&idx, x);
+    return 63u - (U32)idx;
+#elif defined(__GNUC__)
+    return (U32)__builtin_clzll(x);
+#else
+    U32 n = 0u;
+    while (((x << n) >> 63) == 0u) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/* the character at p, or '\0' if p is not among the avail characters from str */
+PLY_INLINE char peekChar(const char* str, const U64 avail, const char* p)
+{
+    return (U64)(p - str) < avail ? *p : '\0';
+}
+
+/* parses [+-]digits[.digits][(e|E)[+-]digits] from at most avail characters, returns false if there are no digits */
+static bool parseDecimal(const char* str, const U64 avail, struct PlyDecimal* out)
+{
+    const char* p = str;
+    out->negative = peekChar(str, avail, p) == '-';
+    if (peekChar(str, avail, p) == '-' || peekChar(str, avail, p) == '+') {
+        ++p;
+    }
+    if (peekChar(str, avail, p) == '0' && (peekChar(str, avail, p + 1) == 'x' || peekChar(str, avail, p + 1) == 'X')) {
+        return false; /* hexadecimal float */
+    }
+
+    const char* integerBegin = p;
+    U64 w = 0u;
+    while (isDecimalDigit(peekChar(str, avail, p))) {
+        w = w * 10u + (U64)(*p - '0'); /* may overflow, corrected below */
+        ++p;
+    }
+    const char* integerEnd = p;
+    I64 digitCount = integerEnd - integerBegin;
+    I64 exponent = 0;
+    const char* fractionBegin = p;
+    const char* fractionEnd = p;
+    if (peekChar(str, avail, p) == '.') {
+        ++p;
+        fractionBegin = p;
+        while (isDecimalDigit(peekChar(str, avail, p))) {
+            w = w * 10u + (U64)(*p - '0');
+            ++p;
+        }
+        fractionEnd = p;
+        exponent = fractionBegin - fractionEnd;
+        digitCount -= exponent;
+    }
+    if (digitCount == 0) {
+        return false;
+    }
+
+    I64 explicitExponent = 0;
+    if (peekChar(str, avail, p) == 'e' || peekChar(str, avail, p) == 'E') {
+        const char* e = p;
+        bool negativeExponent = false;
+        ++p;
+        if (peekChar(str, avail, p) == '-' || peekChar(str, avail, p) == '+') {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        if (!isDecimalDigit(peekChar(str, avail, p))) {
+            p = e; /* the 'e' is not part of the number */
         }
         else {
-            if (str[i] < '0' || str[i] > '9') {
-                break;
-            }
-            else {
-                if (negative == 0) {
-                    if (num > (INT8_MAX - (str[i] - '0')) / 10) {
-                        if (strLenOut)
-                            *strLenOut = 0;
-                        return 0;
-                    }
-                }
-                else {
-                    if (num > (I8)(abs(INT8_MIN) - (str[i] - '0')) / 10) {
-                        if (strLenOut)
-                            *strLenOut = 0;
-                        return 0;
-                    }
+            while (isDecimalDigit(peekChar(str, avail, p))) {
+                if (explicitExponent < 0x10000000) {
+                    explicitExponent = explicitExponent * 10 + (*p - '0');
                 }
-                num = num * 10 + (str[i] - 48);
-                if (strLenOut)
-                    (*strLenOut)++;
+                ++p;
             }
+            if (negativeExponent) {
+                explicitExponent = -explicitExponent;
+            }
+            exponent += explicitExponent;
         }
     }
-    if (negative)
-        num *= -1;
-    return num;
-}
+    out->length = p - str;
+    out->tooManyDigits = false;
 
-I16 strtoi16(const char* str, U8* strLenOut)
-{
-    if (strLenOut) /* 0-init */
-        *strLenOut = 0;
-    I16 num = 0;
-    char negative = 0u;
-    if (*str == '-') {
-        negative = 1;
-        str++;
-    }
-    const U8 max_digits = 5;
-    I8 i = 0;
-    for (; i <= max_digits; ++i)
-    {
-        if (i == max_digits) {
-            if (!(str[i] == '\0' || str[i] == '\r' || str[i] == '\n') && !isspace(str[i])) {
-                *strLenOut = 0x0;
-                return 0x0;
+    if (digitCount > 19) {
+        /* leading zeros are not significant */
+        const char* c = integerBegin;
+        while (c != fractionEnd && (*c == '0' || *c == '.')) {
+            if (*c == '0') {
+                --digitCount;
             }
+            ++c;
         }
-        else {
-            if (str[i] < '0' || str[i] > '9') {
-                break;
+        if (digitCount > 19) {
+            /* keep the first 19 significant digits */
+            const U64 minNineteenDigits = 1000000000000000000u;
+            out->tooManyDigits = true;
+            w = 0u;
+            c = integerBegin;
+            while (w < minNineteenDigits && c != integerEnd) {
+                w = w * 10u + (U64)(*c - '0');
+                ++c;
+            }
+            if (w >= minNineteenDigits) {
+                exponent = (integerEnd - c) + explicitExponent;
             }
             else {
-                if (negative == 0) {
-                    if (num > (INT16_MAX - (str[i] - '0')) / 10) {
-                        if (strLenOut)
-                            *strLenOut = 0;
-                        return 0;
-                    }
-                }
-                else {
-                    if (num > (I16)(abs(INT16_MIN) - (str[i] - '0')) / 10) {
-                        if (strLenOut)
-                            *strLenOut = 0;
-                        return 0;
-                    }
+                c = fractionBegin;
+                while (w < minNineteenDigits && c != fractionEnd) {
+                    w = w * 10u + (U64)(*c - '0');
+                    ++c;
                 }
-                num = num * 10 + (str[i] - 48);
-                if (strLenOut)
-                    (*strLenOut)++;
+                exponent = (fractionBegin - c) + explicitExponent;
             }
         }
     }
-    if (negative)
-        num *= -1;
-    return num;
+
+    out->mantissa = w;
+    out->exponent = exponent;
+    return true;
 }
 
-I32 strtoi32(const char* str, U8* strLenOut)
+/* Eisel-Lemire, computes the mantissa and biased exponent nearest to w * 10^q */
+static void computeBinaryFloat(const struct PlyBinaryFormat* format, const I64 q, U64 w, U64* mantissaOut, I32* power2Out)
 {
-    if (strLenOut) /* 0-init */
-        *strLenOut = 0;
-    I32 num = 0;
-    char negative = 0u;
-    if (*str == '-') {
-        negative = 1;
-        str++;
+    if (w == 0u || q < format->smallestPowerOfTen) {
+        *mantissaOut = 0u;
+        *power2Out = 0;
+        return;
+    }
+    if (q > format->largestPowerOfTen) {
+        *mantissaOut = 0u;
+        *power2Out = format->infinitePower;
+        return;
+    }
+
+    const U32 lz = plyClz64(w);
+    w <<= lz;
+
+    /* 128 bit product of w and 5^q, the second word of 5^q is only needed if the first product could be off */
+    const U32 index = 2u * (U32)(q - PLY_SMALLEST_POWER_OF_FIVE);
+    U64 high;
+    U64 low = plyMul128(w, plyPowersOfFive128[index], &high);
+    const U64 precisionMask = UINT64_MAX >> (format->mantissaExplicitBits + 3);
+    if ((high & precisionMask) == precisionMask) {
+        U64 secondHigh;
+        plyMul128(w, plyPowersOfFive128[index + 1u], &secondHigh);
+        low += secondHigh;
+        if (secondHigh > low) {
+            ++high;
+        }
     }
 
-    const U8 max_digits = 5;
+    const I32 upperBit = (I32)(high >> 63);
+    const I32 shift = upperBit + 64 - format->mantissaExplicitBits - 3;
+    U64 mantissa = high >> shift;
+    /* floor(log2(10^q)) + 63 */
+    I32 power2 = (I32)((((152170 + 65536) * q) >> 16) + 63) + upperBit - (I32)lz - format->minimumExponent;
 
-    I8 i = 0;
-    for (; i <= max_digits; ++i)
-    {
-        if (i == max_digits) {
-            if (!(str[i] == '\0' || str[i] == '\r' || str[i] == '\n') && !isspace(str[i])) {
-                *strLenOut = 0x0;
-                return 0x0;
-            }
+    if (power2 <= 0) {
+        /* subnormal */
+        if (-power2 + 1 >= 64) {
+            *mantissaOut = 0u;
+            *power2Out = 0;
+            return;
         }
-        else {
-            if (str[i] < '0' || str[i] > '9') {
-                break;
-            }
-            else {
-                if (negative == 0) {
-                    if (num > (INT32_MAX - (str[i] - '0')) / 10) {
-                        if (strLenOut)
-                            *strLenOut = 0;
-                        return 0;
-                    }
-                }
-                else {
-                    if (num > (I32)(abs(INT32_MIN) - (str[i] - '0')) / 10) {
-                        if (strLenOut)
-                            *strLenOut = 0;
-                        return 0;
-                    }
-                }
-                num = num * 10 + (str[i] - 48);
-                if (strLenOut)
-                    (*strLenOut)++;
-            }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1u;
+        mantissa >>= 1;
+        /* rounding up may have made it a normal number */
+        *power2Out = mantissa < ((U64)1u << format->mantissaExplicitBits) ? 0 : 1;
+        *mantissaOut = mantissa;
+        return;
+    }
+
+    /* exactly halfway between two floats, round to even */
+    if (low <= 1u && q >= format->minExponentRoundToEven && q <= format->maxExponentRoundToEven && (mantissa & 3u) == 1u) {
+        if ((mantissa << shift) == high) {
+            mantissa &= ~(U64)1u;
         }
     }
-    if (negative)
-        num *= -1;
-    return num;
-}
 
-I64 strtoi64(const char* str, U8* strLenOut)
-{
-    if (strLenOut) /* 0-init */
-        *strLenOut = 0;
-    I64 num = 0;
-    char negative = 0u;
-    if (*str == '-') {
-        negative = 1;
-        str++;
+    mantissa += mantissa & 1u;
+    mantissa >>= 1;
+    if (mantissa >= ((U64)2u << format->mantissaExplicitBits)) {
+        mantissa = (U64)1u << format->mantissaExplicitBits;
+        ++power2;
+    }
+    mantissa &= ~((U64)1u << format->mantissaExplicitBits);
+    if (power2 >= format->infinitePower) {
+        power2 = format->infinitePower;
+        mantissa = 0u;
     }
-    const U8 max_digits = 5;
+    *mantissaOut = mantissa;
+    *power2Out = power2;
+}
 
-    I8 i = 0;
-    for (; i <= max_digits; ++i)
-    {
-        if (i == max_digits) {
-            if (!(str[i] == '\0' || str[i] == '\r' || str[i] == '\n') && !isspace(str[i])) {
-                *strLenOut = 0x0;
-                return 0x0;
-            }
-        }
-        else {
-            if (str[i] < '0' || str[i] > '9') {
-                break;
-            }
-            else {
-                if (negative == 0) {
-                    if (num > (INT64_MAX - (str[i] - '0')) / 10) {
-                        if (strLenOut)
-                            *strLenOut = 0;
-                        return 0;
-                    }
-                }
-                else {
-                    if (num > (I64)(llabs(INT64_MIN) - (str[i] - '0')) / 10) {
-                        if (strLenOut)
-                            *strLenOut = 0;
-                        return 0;
-                    }
-                }
-                num = num * 10 + (str[i] - 48);
-                if (strLenOut)
-                    (*strLenOut)++;
-            }
+/* converts a parsed decimal to the bits of a binary float. Returns false if the fallback must be used. */
+static bool decimalToBinaryFloat(const struct PlyBinaryFormat* format, const struct PlyDecimal* decimal, U64* bitsOut)
+{
+    U64 mantissa;
+    I32 power2;
+    computeBinaryFloat(format, decimal->exponent, decimal->mantissa, &mantissa, &power2);
+    if (decimal->tooManyDigits) {
+        /* the dropped digits only matter if they could round the value differently */
+        U64 upperMantissa;
+        I32 upperPower2;
+        computeBinaryFloat(format, decimal->exponent, decimal->mantissa + 1u, &upperMantissa, &upperPower2);
+        if (mantissa != upperMantissa || power2 != upperPower2) {
+            return false;
         }
     }
-    if (negative)
-        num *= -1;
-    return num;
+    *bitsOut = mantissa | ((U64)power2 << format->mantissaExplicitBits);
+    if (decimal->negative) {
+        *bitsOut |= (U64)1u << format->signIndex;
+    }
+    return true;
 }
 
-
-float strtof32(const char* str, U8* strLenOut)
+/* libc fallback, used for inf, nan, hex floats and decimals with too many digits to round from 19.
+The decimal point is swapped for the one of the current locale so that the result does not depend on it. */
+static double parseFloatFallback(const char* str, const U64 avail, const bool isFloat, U8* strLenOut)
 {
-    const char* start = str;
+    char buff[256];
+    const char decimalPoint = localeconv()->decimal_point[0];
+    U32 len = 0u;
+    while (len < sizeof(buff) - 1 && len < avail && str[len] != '\0' && (isalnum((unsigned char)str[len]) || str[len] == '.' || str[len] == '+' || str[len] == '-')) {
+        buff[len] = str[len] == '.' ? decimalPoint : str[len];
+        ++len;
+    }
+    buff[len] = '\0';
+
     char* end;
     errno = 0;
-    float num = strtof(str, &end);
-    if (errno == ERANGE) {
+    const double num = isFloat ? (double)strtof(buff, &end) : strtod(buff, &end);
+    if (errno == ERANGE && (num == HUGE_VAL || num == -HUGE_VAL)) {
         if (strLenOut)
             *strLenOut = 0x0;
         return 0;
     }
     if (strLenOut)
-        *strLenOut = (U8)(end - start);
-
+        *strLenOut = (U8)(end - buff);
     return num;
 }
 
-double strtod64(const char* str, U8* strLenOut)
+/* parses a float from at most avail characters */
+static float parseFloatBounded(const char* str, const U64 avail, U8* strLenOut)
 {
-    const char* start = str;
-    char* end;
-    errno = 0;
-    double num = strtod(str, &end);
-    if (errno == ERANGE) {
+    struct PlyDecimal decimal;
+    if (!parseDecimal(str, avail, &decimal) || decimal.length > UINT8_MAX) {
+        return (float)parseFloatFallback(str, avail, true, strLenOut);
+    }
+
+    float num;
+#if PLY_EXACT_FLOAT_EVAL
+    static const float exactPowersOfTen[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+    /* Clinger's fast path, both operands are exact so one rounding gives the correct result */
+    if (!decimal.tooManyDigits && decimal.mantissa <= ((U64)1u << 24) && decimal.exponent >= -10 && decimal.exponent <= 10) {
+        num = (float)decimal.mantissa;
+        num = decimal.exponent < 0 ? num / exactPowersOfTen[-decimal.exponent] : num * exactPowersOfTen[decimal.exponent];
+        if (decimal.negative)
+            num = -num;
+        if (strLenOut)
+            *strLenOut = (U8)decimal.length;
+        return num;
+    }
+#endif
+
+    U64 bits;
+    if (!decimalToBinaryFloat(&plyBinary32Format, &decimal, &bits)) {
+        return (float)parseFloatFallback(str, avail, true, strLenOut);
+    }
+    if (((bits >> 23) & 0xFFu) == 0xFFu) {
+        /* out of range */
         if (strLenOut)
             *strLenOut = 0x0;
         return 0;
     }
+    const U32 bits32 = (U32)bits;
+    memcpy(&num, &bits32, sizeof(num));
     if (strLenOut)
-        *strLenOut = (U8)(end - start);
-   
+        *strLenOut = (U8)decimal.length;
+    return num;
+}
 
+/* parses a double from at most avail characters */
+static double parseDoubleBounded(const char* str, const U64 avail, U8* strLenOut)
+{
+    struct PlyDecimal decimal;
+    if (!parseDecimal(str, avail, &decimal) || decimal.length > UINT8_MAX) {
+        return parseFloatFallback(str, avail, false, strLenOut);
+    }
+
+    double num;
+#if PLY_EXACT_FLOAT_EVAL
+    static const double exactPowersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    /* Clinger's fast path, both operands are exact so one rounding gives the correct result */
+    if (!decimal.tooManyDigits && decimal.mantissa <= ((U64)1u << 53) && decimal.exponent >= -22 && decimal.exponent <= 22) {
+        num = (double)decimal.mantissa;
+        num = decimal.exponent < 0 ? num / exactPowersOfTen[-decimal.exponent] : num * exactPowersOfTen[decimal.exponent];
+        if (decimal.negative)
+            num = -num;
+        if (strLenOut)
+            *strLenOut = (U8)decimal.length;
+        return num;
+    }
+#endif
 
+    U64 bits;
+    if (!decimalToBinaryFloat(&plyBinary64Format, &decimal, &bits)) {
+        return parseFloatFallback(str, avail, false, strLenOut);
+    }
+    if (((bits >> 52) & 0x7FFu) == 0x7FFu) {
+        /* out of range */
+        if (strLenOut)
+            *strLenOut = 0x0;
+        return 0;
+    }
+    memcpy(&num, &bits, sizeof(num));
+    if (strLenOut)
+        *strLenOut = (U8)decimal.length;
     return num;
 }
 
+/* the string is null terminated, which stops the parsers like any other character that is not part of a number */
+float strtof32(const char* str, U8* strLenOut)
+{
+    return parseFloatBounded(str, UINT64_MAX, strLenOut);
+}
+
+double strtod64(const char* str, U8* strLenOut)
+{
+    return parseDoubleBounded(str, UINT64_MAX, strLenOut);
+}
+
 
 
 #ifdef __cplusplus
@@ -31,7 +31,6 @@ namespace cply {
 #include <stdint.h>
 #include <string.h>
 
-#define C_PLY_MAX_LINE_LENGTH ((uint32_t)200000lu)
 #define PLY_MAX_ELEMENT_AND_PROPERTY_NAME_LENGTH ((uint16_t)127u)
 #define PLY_LOAD_ALL_ELEMENTS 0u
 #define PLY_FORMAT_BINARY_MATCH_SYSTEM ~((uint32_t)0)
@@ -57,7 +56,6 @@ namespace cply {
 
 #include "ASM/streqlasm.h"
 
-PLY_STATIC_ASSERT(C_PLY_MAX_LINE_LENGTH >= 2, "C_PLY_MAX_LINE_LENGTH must be 2 or greater");
 PLY_STATIC_ASSERT(PLY_MAX_ELEMENT_AND_PROPERTY_NAME_LENGTH >= 2, "PLY_MAX_ELEMENT_AND_PROPERTY_NAME_LENGTH must be 2 or greater");
 
 #ifdef _MSC_VER
@@ -159,9 +157,21 @@ union PlyScalarUnion
 
 struct PlyProperty
 {
+	/*must not be edited once the property was added to an element, the element's name lookups would not find it*/
 	char name[PLY_MAX_ELEMENT_AND_PROPERTY_NAME_LENGTH+1];
 
 	U32* dataLineOffsets;
+	/*offset from the beginning of a data line, only valid if the owning element has a dataLineStride*/
+	U32 dataLineOffset;
+	/*number of values in every list of this property, 0 if it is not a list or the lists differ in length*/
+	U32 listArity;
+	/*if true, the lists are stored without their counts, listArity values per data line*/
+	char denseList;
+	/*only set if the scene was loaded with columnarData. The values of this property on every data line, back to back.
+	The values of a list property are stored the same way and split into lists by listOffsets.*/
+	void* columnData;
+	/*only set for lists if the scene was loaded with columnarData. dataLineCount + 1 entries, the values of list i are columnData[listOffsets[i]] . . . columnData[listOffsets[i + 1] - 1]*/
+	U64* listOffsets;
 
 	enum PlyScalarType listCountType; /*undefined if it's not a list*/
 	enum PlyDataType dataType;
@@ -176,16 +186,49 @@ enum PlyFormat
 	PLY_FORMAT_BINARY_LITTLE_ENDIAN
 };
 
+struct PlyNameSlot
+{
+	U32 hash;
+	U32 index; /*index of the name + 1, 0 if the slot is empty*/
+};
+
+/*open addressing hash table from names to indices, used by the name lookups*/
+struct PlyNameTable
+{
+	struct PlyNameSlot* slots;
+	U32 capacity;
+	/*number of names in the table. If it is not the number of elements or properties, such as after they were added by hand, lookups fall back to comparing every name*/
+	U32 count;
+	/*number of PlyElementSetName calls when the table was filled. A scene's element names are compared one by one until the table is refilled by the next element added to the scene*/
+	U32 renameCount;
+};
+
+/*a name and its hash, so that lookups of the same name in many elements do not hash it again. The string must outlive the handle*/
+struct PlyNameHandle
+{
+	const char* name;
+	U32 hash;
+};
+
 struct PlyElement
 {
+	/*set with PlyElementSetName, editing it in place leaves the scene's name lookups stale*/
 	char name[PLY_MAX_ELEMENT_AND_PROPERTY_NAME_LENGTH + 1];
 	struct PlyProperty* properties;
 	void* data;
 	U32 propertyCount;
 	U32 dataLineCount;
+	/*size of a data line in bytes if every data line has the same size, otherwise 0. That is the case if every property is a scalar,
+	or if the only property is a list whose lists all have the same listArity, then the stride includes the list count,
+	or only the listArity values if the property is a denseList*/
+	U32 dataLineStride;
 	U64 dataSize;
 
 	U64* dataLineBegins;
+	/*the names of the properties*/
+	struct PlyNameTable propertyNames;
+	/*true if the element belongs to a scene loaded with sceneArena. Such an element is read-only, adding properties, data lines or data to it returns PLY_GENERIC_ERROR*/
+	char inArena;
 };
 
 struct PlyObjectInfo
@@ -194,12 +237,76 @@ struct PlyObjectInfo
 	double value;
 };
 
+/*names the properties of an element that will be loaded*/
+struct PlyPropertySelection
+{
+	const char* element;
+	const char** properties; /*don't forget to set propertyCount*/
+	U32 propertyCount;
+};
+
+/*writes the values of one scalar property to a caller's buffer, converted to type*/
+struct PlyPropertyBinding
+{
+	const char* property;
+	/*the value of data line i is written to PlyElementBinding::dst + i * stride + offset*/
+	U64 offset;
+	U64 stride;
+	enum PlyScalarType type;
+	/*if true, integer values are mapped to and from [-1, 1] for signed types and [0, 1] for unsigned types, like snorm16 or unorm8.
+	Float values are clamped to that range when they are written to an integer type.*/
+	char normalized;
+};
+
+/*decodes an element straight into a caller's buffer, such as an interleaved vertex buffer, instead of storing it in the scene.
+Properties without a binding are passed over, and bindings of properties the element does not have are ignored.
+Bytes of dst that no binding covers are left as they are.*/
+struct PlyElementBinding
+{
+	const char* element;
+	const struct PlyPropertyBinding* properties; /*don't forget to set propertyCount*/
+	U32 propertyCount;
+	void* dst;
+	/*number of data lines dst has room for, larger elements fail to load with PLY_EXCEEDS_BOUND_LIMITS_ERROR*/
+	U64 dataLineCapacity;
+};
+
 struct PlyLoadInfo
 {
 	const char** elements; /*don't forget to set elementsCount*/
 	U32 elementCount;
 	char saveComments;
 	char allowAnyVersion;
+	/*if true, elements with a dataLineStride will not allocate dataLineBegins or dataLineOffsets, 
+	and elements with lists will only allocate dataLineBegins. Use PlyGetPropertyData() to access the data.
+	PlyWriteData and PlyWriteDataList need the offset tables, so they return PLY_GENERIC_ERROR for such elements.*/
+	char compactDataLines;
+	/*if true, the element data of binary files will point directly into the memory passed to PlyLoadFromMemory instead of being copied.
+	The memory must outlive the scene. Files that do not match the system endianness are still copied, unless borrowedMemoryIsWritable is set.*/
+	char borrowMemory;
+	/*if true, borrowed memory may be byte swapped in place*/
+	char borrowedMemoryIsWritable;
+	/*if true, a binary element made of one list property whose lists all have the same length (such as triangle faces)
+	is stored as a dense array of listArity values per data line, without list counts. Ignored while borrowing memory.*/
+	char denseLists;
+	/*number of threads used to parse ASCII data or to copy and byte swap binary element data. 0 and 1 load on the calling thread.*/
+	U32 threadCount;
+	/*if set, elements named by a selection only get the listed properties, the others are passed over without being stored.
+	Elements without a selection keep all of their properties. borrowMemory is ignored for binary files that narrow an element.*/
+	const struct PlyPropertySelection* propertySelections; /*don't forget to set propertySelectionCount*/
+	U32 propertySelectionCount;
+	/*if true, the values of every property are stored in PlyProperty::columnData as one contiguous, 64 byte aligned array of its scalar type,
+	and lists also get PlyProperty::listOffsets. Elements will have no data or data lines, and the scene can not be saved.
+	compactDataLines, borrowMemory and denseLists are ignored.*/
+	char columnarData;
+	/*if set, the elements named by a binding are decoded straight into the caller's buffers. They stay in the scene with their properties and dataLineCount,
+	but without data, so the scene can not be saved. Only scalar properties can be bound.*/
+	const struct PlyElementBinding* elementBindings; /*don't forget to set elementBindingCount*/
+	U32 elementBindingCount;
+	/*if true, the elements, properties, names, comments, obj_infos and data line tables of the scene are placed in a few large blocks, the first sized from the header,
+	which PlyDestroyScene releases at once. Element data is allocated as usual. Such a scene is read-only: the functions that add elements, properties,
+	data lines, data, comments or obj_infos to it or its elements return PLY_GENERIC_ERROR, and its elements can not be written to another scene.*/
+	char sceneArena;
 };
 
 struct PlySaveInfo
@@ -221,6 +328,14 @@ struct PlyScene
 	U32 objectInfoCount;
 	enum PlyFormat format;
 	float versionNumber;
+	/*if true, sharedElementData belongs to the memory the scene was loaded from and will not be freed by PlyDestroyScene*/
+	char borrowsElementData;
+	/*if not 0, sharedElementData is a memory mapped file of this size, created by PlyLoadFromDisk with borrowMemory set*/
+	U64 mappedElementDataSize;
+	/*the names of the elements*/
+	struct PlyNameTable elementNames;
+	/*if not NULL, the scene was loaded with sceneArena and everything but its element data lives in these blocks*/
+	void* arena;
 };
 
 
@@ -306,6 +421,21 @@ PLY_INLINE double PlyScaleBytesToD64(const void* data, const enum PlyScalarType
 /// @return U8 - Size of scalar type (1 . . . 8) */
 PLY_INLINE U8 PlyGetSizeofScalarType(const enum PlyScalarType type);
 
+/*
+/// Returns the beginning of a data line of an element
+/// @param const PlyElement* element - element to read from
+/// @param const U32 dataLineIdx - index of the data line
+/// @return void* - beginning of the data line */
+PLY_INLINE void* PlyGetDataLine(const struct PlyElement* element, const U32 dataLineIdx);
+
+/*
+/// Returns the location of a property's data on a given data line. Works with or without compactDataLines.
+/// @param const PlyElement* element - element to read from
+/// @param const U32 propertyIdx - index of the property within the element
+/// @param const U32 dataLineIdx - index of the data line
+/// @return void* - beginning of the property's data. For lists this is the list count, followed by the list values, or only the listArity values if the property is a denseList. */
+PLY_INLINE void* PlyGetPropertyData(const struct PlyElement* element, const U32 propertyIdx, const U32 dataLineIdx);
+
 /*
 /// Converts a str to a scalar type
 /// @param const char* str - c string to read from
@@ -345,6 +475,26 @@ PLY_H_FUNCTION_PREFIX I64 PlyGetPropertyIndex(const struct PlyElement* element,
 * If the element is not in that property, -1 will be returned. */
 PLY_H_FUNCTION_PREFIX I64 PlyGetPropertyIndexByName(const struct PlyElement* element, const char* propertyName);
 
+/*
+* returns the index of a property within an element from a handle made by PlyInternName.
+* If the property is not in that element, -1 will be returned. */
+PLY_H_FUNCTION_PREFIX I64 PlyGetPropertyIndexByHandle(const struct PlyElement* element, const struct PlyNameHandle* propertyName);
+
+/*
+* returns the index of an element within a scene from it's name.
+* If the element is not in that scene, -1 will be returned. */
+PLY_H_FUNCTION_PREFIX I64 PlyGetElementIndexByName(const struct PlyScene* scene, const char* elementName);
+
+/*
+* returns the index of an element within a scene from a handle made by PlyInternName.
+* If the element is not in that scene, -1 will be returned. */
+PLY_H_FUNCTION_PREFIX I64 PlyGetElementIndexByHandle(const struct PlyScene* scene, const struct PlyNameHandle* elementName);
+
+/*
+* hashes a name once, for repeated lookups with the ByHandle functions.
+* The handle points to name, which must outlive it. */
+PLY_H_FUNCTION_PREFIX struct PlyNameHandle PlyInternName(const char* name);
+
 
 /* adds a PlyProperty to an element. The property will be copied, thus transferring ownership */
 PLY_INLINE enum PlyResult PlyElementAddProperty(struct PlyElement* element, struct PlyProperty* property);
@@ -355,6 +505,7 @@ PLY_INLINE enum PlyResult PlySceneAddObjectInfo(struct PlyScene* scene, struct P
 /* adds a PlyElement to a scene. The element will be copied, thus transferring ownership */
 PLY_INLINE enum PlyResult  PlySceneAddElement(struct PlyScene* scene, struct PlyElement* element);
 
+/* renames an element, which may already be in a scene. Element and property names must not be edited in place once they were added, because the name lookups would not find them */
 PLY_H_FUNCTION_PREFIX enum PlyResult PlyElementSetName(struct PlyElement* element, const char* name); 
 
 
@@ -367,7 +518,7 @@ PLY_H_FUNCTION_PREFIX enum PlyResult PlyElementSetName(struct PlyElement* elemen
 PLY_H_FUNCTION_PREFIX enum PlyResult PlyLoadFromMemory(const U8* mem, U64 memSize, struct PlyScene* scene, struct PlyLoadInfo* loadInfo);
 
 /*
-/// Loads a PlyScene from a given filename.
+/// Loads a PlyScene from a given filename. On unix systems the file is memory mapped and parsed directly from the mapping.
 /// @param const char* fileName - filename to read
 /// @param struct PlyScene* scene - scene to write to
 /// @param struct PlyLoadInfo* loadInfo - optional constraints that can be placed on scene parsing */
@@ -468,6 +619,53 @@ PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataByName(struct PlyElement* eleme
 /// @return PlyResult - return code*/
 PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataListByName(struct PlyElement* element, const U32 datalineIdx, const char* propertyName, const U32 listCount, const void* values);
 
+/*
+/// Writes data to the property of an element by a handle made by PlyInternName, without hashing the name again.
+/// @param PlyElement* element - parent element of property
+/// @param const U32 datalineIdx - data line to write to
+/// @param const PlyNameHandle* propertyName - name of the property to write to
+/// @param const PlyScalarUnion - value to write to 
+/// @return PlyResult - return code*/
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataByHandle(struct PlyElement* element, const U32 datalineIdx, const struct PlyNameHandle* propertyName, const union PlyScalarUnion value);
+
+/*
+/// Writes data as a list to the property of an element by a handle made by PlyInternName, without hashing the name again.
+/// @param PlyElement* element - parent element of property
+/// @param const U32 datalineIdx - data line to write to
+/// @param const PlyNameHandle* propertyName - name of the property to write to
+/// @praram const U32 listCount - number of values to write. Must equal the count of the values array.
+/// @param const void* values - values to write, must be a pointer to an array with the same scalar type as the property and a count of listCount.
+/// @return PlyResult - return code*/
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyWriteDataListByHandle(struct PlyElement* element, const U32 datalineIdx, const struct PlyNameHandle* propertyName, const U32 listCount, const void* values);
+
+
+/*
+/// Copies a scalar property of the data lines [rowBegin, rowBegin + rowCount) of an element into a contiguous array, converted to dstType.
+/// Works with or without compactDataLines, and with columnarData. Common conversions, such as uchar to float or double to float, are vectorized.
+/// @param const PlyElement* element - element to read from
+/// @param const U32 propertyIdx - index of the property within the element, it must not be a list
+/// @param const PlyScalarType dstType - type of the values written to dst
+/// @param void* dst - destination, with room for rowCount values of dstType
+/// @param const U32 rowBegin - index of the first data line to read
+/// @param const U32 rowCount - number of data lines to read
+/// @param const char normalized - if true, integers are mapped to and from [-1, 1] or [0, 1], see PlyPropertyBinding::normalized
+/// @return PlyResult - return code*/
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyExtractColumn(const struct PlyElement* element, const U32 propertyIdx, const enum PlyScalarType dstType, void* dst, const U32 rowBegin, const U32 rowCount, const char normalized);
+
+/*
+/// Copies a list property of every data line of an element into CSR form: offsets holds dataLineCount + 1 entries,
+/// and the values of list i are values[offsets[i]] . . . values[offsets[i + 1] - 1], converted to dstType.
+/// The offsets are always written, so the values can be sized from offsets[dataLineCount] by a first call with values set to NULL.
+/// @param const PlyElement* element - element to read from
+/// @param const U32 propertyIdx - index of the property within the element, it must be a list
+/// @param const PlyScalarType dstType - type of the values written to values
+/// @param U64* offsets - destination of the offsets, with room for dataLineCount + 1 entries
+/// @param void* values - destination of the values, may be NULL
+/// @param const U64 valueCapacity - number of values of dstType that values has room for, if it is too small PLY_EXCEEDS_BOUND_LIMITS_ERROR is returned
+/// @param U32 threadCount - number of threads to use, 0 or 1 runs on the calling thread
+/// @param const char normalized - if true, integers are mapped to and from [-1, 1] or [0, 1], see PlyPropertyBinding::normalized
+/// @return PlyResult - return code*/
+PLY_H_FUNCTION_PREFIX enum PlyResult PlyExtractList(const struct PlyElement* element, const U32 propertyIdx, const enum PlyScalarType dstType, U64* offsets, void* values, const U64 valueCapacity, U32 threadCount, const char normalized);
 
 PLY_H_FUNCTION_PREFIX void PlyDataToString(const U8* data, char* buff, const U16 buffSize, enum PlyScalarType type, const U8 F32DecimalCount, const U16 D64DecimalCount);
 
@@ -34,23 +34,29 @@ PLY_INLINE void PlySwapBytes(U8* mem, const enum PlyScalarType t)
 	switch (t)
 	{
 	case PLY_SCALAR_TYPE_USHORT:
-		*(U16*)mem = PLY_BYTESWAP16(*mem);
-		break;
-	case PLY_SCALAR_TYPE_SHORT:
-		*(U16*)mem = PLY_BYTESWAP16(*mem);
+	case PLY_SCALAR_TYPE_SHORT: {
+		U16 v;
+		memcpy(&v, mem, sizeof(v));
+		v = PLY_BYTESWAP16(v);
+		memcpy(mem, &v, sizeof(v));
 		break;
+	}
 	case PLY_SCALAR_TYPE_UINT:
-		*(U32*)mem = PLY_BYTESWAP32(*mem);
-		break;
 	case PLY_SCALAR_TYPE_INT:
-		*(U32*)mem = PLY_BYTESWAP32(*mem);
+	case PLY_SCALAR_TYPE_FLOAT: {
+		U32 v;
+		memcpy(&v, mem, sizeof(v));
+		v = PLY_BYTESWAP32(v);
+		memcpy(mem, &v, sizeof(v));
 		break;
-	case PLY_SCALAR_TYPE_FLOAT:
-		*(U32*)mem = PLY_BYTESWAP32(*mem);
-		break;
-	case PLY_SCALAR_TYPE_DOUBLE:
-		*(U64*)mem = PLY_BYTESWAP64(*mem);
+	}
+	case PLY_SCALAR_TYPE_DOUBLE: {
+		U64 v;
+		memcpy(&v, mem, sizeof(v));
+		v = PLY_BYTESWAP64(v);
+		memcpy(mem, &v, sizeof(v));
 		break;
+	}
     default:
         break;
 	}
@@ -558,4 +564,39 @@ PLY_INLINE U8 PlyGetSizeofScalarType(const enum PlyScalarType type)
     return tbl[type];
 }
 
+PLY_INLINE void* PlyGetDataLine(const struct PlyElement* element, const U32 dataLineIdx)
+{
+    if (element->dataLineBegins) {
+        return (U8*)element->data + element->dataLineBegins[dataLineIdx];
+    }
+    return (U8*)element->data + (U64)element->dataLineStride * dataLineIdx;
+}
+
+PLY_INLINE void* PlyGetPropertyData(const struct PlyElement* element, const U32 propertyIdx, const U32 dataLineIdx)
+{
+    const struct PlyProperty* property = element->properties + propertyIdx;
+    U8* line = (U8*)PlyGetDataLine(element, dataLineIdx);
+
+    if (property->dataLineOffsets) {
+        return line + property->dataLineOffsets[dataLineIdx];
+    }
+    if (element->dataLineStride != 0u) {
+        return line + property->dataLineOffset;
+    }
+
+    /* list element without offset tables, walk the properties that precede it on the data line */
+    U32 pi = 0u;
+    for (; pi < propertyIdx; ++pi) {
+        const struct PlyProperty* prev = element->properties + pi;
+        if (prev->dataType == PLY_DATA_TYPE_LIST) {
+            const U64 listCount = PlyScaleBytesToU64(line, prev->listCountType);
+            line += PlyGetSizeofScalarType(prev->listCountType) + listCount * PlyGetSizeofScalarType(prev->scalarType);
+        }
+        else {
+            line += PlyGetSizeofScalarType(prev->scalarType);
+        }
+    }
+    return line;
+}
+
 #endif /* !C_POLYGON_INLINE */
\ No newline at end of file